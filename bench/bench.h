@@ -0,0 +1,117 @@
+#ifndef AOC_BENCH_BENCH_H
+#define AOC_BENCH_BENCH_H
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+namespace bench
+{
+
+// keeps the compiler from optimizing away the computation of value
+template<typename T>
+inline void do_not_optimize(T const &value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r"(&value) : "memory");
+#else
+	static void const *volatile sink;
+	sink = &value;
+#endif
+}
+
+struct day_t
+{
+	int number;
+	// loads the given input file, and returns the two parts as callables that run on the loaded
+	// input, so the input parsing isn't included in the measurements
+	// a day without a second part leaves it empty
+	std::function<std::array<std::function<void()>, 2>(fs::path const &)> load;
+};
+
+inline vector<day_t> &days(void)
+{
+	static vector<day_t> result;
+	return result;
+}
+
+namespace internal
+{
+
+template<typename T>
+struct is_tuple_like : std::false_type {};
+
+template<typename ...Ts>
+struct is_tuple_like<std::tuple<Ts...>> : std::true_type {};
+
+template<typename T, typename U>
+struct is_tuple_like<std::pair<T, U>> : std::true_type {};
+
+// solutions that take more than one argument get the elements of a pair or tuple input
+template<typename Part, typename Input>
+decltype(auto) call_part(Part const &part, Input const &input)
+{
+	if constexpr (std::is_invocable_v<Part const &, Input const &>)
+	{
+		return part(input);
+	}
+	else
+	{
+		static_assert(is_tuple_like<Input>::value);
+		return std::apply(part, input);
+	}
+}
+
+template<typename Part, typename Input>
+std::function<void()> make_runner(Part part, std::shared_ptr<Input const> input)
+{
+	return [part = std::move(part), input = std::move(input)]() {
+		if constexpr (std::is_void_v<decltype(call_part(part, *input))>)
+		{
+			call_part(part, *input);
+		}
+		else
+		{
+			auto const result = call_part(part, *input);
+			do_not_optimize(result);
+		}
+	};
+}
+
+} // namespace internal
+
+// registers a day for the benchmark driver; every day defines one of these when built with AOC_BENCH
+// the parts are timed separately, so a day whose main solves both parts with one pass registers
+// each part as its own call of that pass
+struct day_registration
+{
+	template<typename LoadInput, typename Part1>
+	day_registration(int number, LoadInput load_input, Part1 part_1)
+	{
+		days().push_back({
+			number,
+			[=](fs::path const &file) -> std::array<std::function<void()>, 2> {
+				auto const input = std::make_shared<decltype(load_input(file)) const>(load_input(file));
+				return { internal::make_runner(part_1, input), std::function<void()>() };
+			}
+		});
+	}
+
+	template<typename LoadInput, typename Part1, typename Part2>
+	day_registration(int number, LoadInput load_input, Part1 part_1, Part2 part_2)
+	{
+		days().push_back({
+			number,
+			[=](fs::path const &file) -> std::array<std::function<void()>, 2> {
+				auto const input = std::make_shared<decltype(load_input(file)) const>(load_input(file));
+				return { internal::make_runner(part_1, input), internal::make_runner(part_2, input) };
+			}
+		});
+	}
+};
+
+} // namespace bench
+
+#endif // AOC_BENCH_BENCH_H
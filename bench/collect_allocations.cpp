@@ -0,0 +1,123 @@
+#include "common.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// the number of allocations of collect and collect_into on pipelines with a size hint
+// the sized pipelines allocate once, and collecting into a buffer that is large enough doesn't
+// allocate at all; exits with an error if a count differs from the expected one
+
+static std::atomic<std::size_t> allocation_count = 0;
+
+void *operator new (std::size_t size)
+{
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	auto const result = std::malloc(size == 0 ? 1 : size);
+	if (result == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void operator delete (void *ptr) noexcept
+{ std::free(ptr); }
+
+void operator delete (void *ptr, std::size_t) noexcept
+{ std::free(ptr); }
+
+namespace
+{
+
+struct result_t
+{
+	std::string_view name;
+	std::size_t allocations;
+	std::size_t expected_allocations;
+};
+
+template<typename Func>
+static std::size_t count_allocations(Func &&func)
+{
+	auto const allocation_count_before = allocation_count.load();
+	func();
+	return allocation_count.load() - allocation_count_before;
+}
+
+template<typename Func>
+static result_t run(std::string_view name, std::size_t expected_allocations, Func &&func)
+{
+	return result_t{ name, count_allocations(func), expected_allocations };
+}
+
+} // namespace
+
+int main(void)
+{
+	constexpr std::size_t element_count = 1 << 16;
+
+	vector<int> data;
+	data.reserve(element_count);
+	for (auto const i : utils::iota(0, static_cast<int>(element_count)))
+	{
+		data.push_back(i * 7 % 1000);
+	}
+	auto const values = span<int const>(data);
+	// about every 64th value
+	auto const is_selected = [](auto const n) { return n % 64 == 0; };
+
+	vector<result_t> results;
+	// the vectors are kept until the end, so freeing them doesn't interfere with the counts
+	vector<int> basic_range_result;
+	results.push_back(run("to_range().collect()", 1, [&]() {
+		basic_range_result = utils::to_range(data).collect<vector>();
+	}));
+	vector<int> iota_result;
+	results.push_back(run("iota().collect()", 1, [&]() {
+		iota_result = utils::iota(0, static_cast<int>(element_count)).collect<vector>();
+	}));
+	vector<std::int64_t> transform_result;
+	results.push_back(run("transform().collect()", 1, [&]() {
+		transform_result = values.transform([](auto const n) { return std::int64_t(n) * n; }).collect<vector>();
+	}));
+
+	vector<int> buffer;
+	buffer.reserve(element_count);
+	results.push_back(run("transform().collect_into()", 0, [&]() {
+		values.transform([](auto const n) { return n + 1; }).collect_into(buffer);
+	}));
+	results.push_back(run("filter().collect_into()", 0, [&]() {
+		values.filter(is_selected).collect_into(buffer);
+	}));
+
+	// a filter only gives an upper bound, which is mostly unused here, so it mustn't be reserved
+	vector<int> filter_result;
+	auto const filter_allocations = count_allocations([&]() {
+		filter_result = values.filter(is_selected).collect<vector>();
+	});
+	auto const is_filter_result_tight = filter_result.capacity() <= 2 * filter_result.size();
+
+	auto is_correct = is_filter_result_tight;
+	fmt::print("{{\n  \"elements\": {},\n  \"results\": [", element_count);
+	for (auto const &[index, result] : results.enumerate())
+	{
+		is_correct = is_correct && result.allocations == result.expected_allocations;
+		fmt::print(
+			"{}\n    {{ \"pipeline\": \"{}\", \"allocations\": {}, \"expected_allocations\": {} }}",
+			index == 0 ? "" : ",",
+			result.name, result.allocations, result.expected_allocations
+		);
+	}
+	fmt::print(
+		",\n    {{ \"pipeline\": \"filter().collect()\", \"allocations\": {}, \"size\": {}, \"capacity\": {} }}",
+		filter_allocations, filter_result.size(), filter_result.capacity()
+	);
+	fmt::print("\n  ]\n}}\n");
+
+	if (!is_correct)
+	{
+		fmt::print(stderr, "error: unexpected allocations\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,1004 @@
+#include "common.h"
+#include <cstdio>
+
+// deterministic input generator for the benchmarks
+// the random numbers come from our own generator and distributions, because the standard
+// distributions give different sequences with different standard libraries
+
+namespace
+{
+
+// the high half of the 128 bit product
+std::uint64_t multiply_high(std::uint64_t lhs, std::uint64_t rhs)
+{
+#ifdef __SIZEOF_INT128__
+	return static_cast<std::uint64_t>((static_cast<unsigned __int128>(lhs) * rhs) >> 64);
+#else
+	// schoolbook multiplication with 32 bit limbs, the middle products are added with their carries
+	auto const lhs_low = lhs & 0xffff'ffff;
+	auto const lhs_high = lhs >> 32;
+	auto const rhs_low = rhs & 0xffff'ffff;
+	auto const rhs_high = rhs >> 32;
+	auto const low_low = lhs_low * rhs_low;
+	auto const high_low = lhs_high * rhs_low;
+	auto const low_high = lhs_low * rhs_high;
+	auto const high_high = lhs_high * rhs_high;
+	auto const middle = (low_low >> 32) + (high_low & 0xffff'ffff) + (low_high & 0xffff'ffff);
+	return high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+#endif
+}
+
+struct rng_t
+{
+	std::uint64_t state[4];
+
+	explicit rng_t(std::uint64_t seed)
+	{
+		// splitmix64 to spread the seed over the state of xoshiro256**
+		for (auto &s : this->state)
+		{
+			seed += 0x9e37'79b9'7f4a'7c15;
+			auto z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9;
+			z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11eb;
+			s = z ^ (z >> 31);
+		}
+	}
+
+	std::uint64_t next(void)
+	{
+		auto const result = std::rotl(this->state[1] * 5, 7) * 9;
+		auto const t = this->state[1] << 17;
+		this->state[2] ^= this->state[0];
+		this->state[3] ^= this->state[1];
+		this->state[1] ^= this->state[2];
+		this->state[0] ^= this->state[3];
+		this->state[2] ^= t;
+		this->state[3] = std::rotl(this->state[3], 45);
+		return result;
+	}
+
+	// uniform in [begin, end]
+	std::int64_t uniform(std::int64_t begin, std::int64_t end)
+	{
+		assert(begin <= end);
+		// the range wraps around to 0 if it is every 64 bit integer, and then the result is the number itself
+		auto const range = static_cast<std::uint64_t>(end) - static_cast<std::uint64_t>(begin) + 1;
+		auto const offset = range == 0 ? this->next() : multiply_high(range, this->next());
+		return static_cast<std::int64_t>(static_cast<std::uint64_t>(begin) + offset);
+	}
+
+	bool chance(double probability)
+	{
+		return static_cast<double>(this->next() >> 11) * 0x1.0p-53 < probability;
+	}
+
+	template<typename T>
+	void shuffle(T &collection)
+	{
+		for (std::size_t i = collection.size(); i > 1; --i)
+		{
+			auto const j = static_cast<std::size_t>(this->uniform(0, static_cast<std::int64_t>(i - 1)));
+			std::swap(collection[i - 1], collection[j]);
+		}
+	}
+};
+
+// buffered writer for large outputs
+struct output_t
+{
+	std::FILE *file;
+	fmt::memory_buffer buffer;
+
+	explicit output_t(fs::path const &path)
+		: file(std::fopen(path.string().c_str(), "wb")), buffer()
+	{}
+
+	output_t(output_t const &) = delete;
+	output_t &operator = (output_t const &) = delete;
+
+	~output_t(void)
+	{
+		this->flush();
+		if (this->file != nullptr)
+		{
+			std::fclose(this->file);
+		}
+	}
+
+	void flush(void)
+	{
+		if (this->file != nullptr)
+		{
+			std::fwrite(this->buffer.data(), 1, this->buffer.size(), this->file);
+		}
+		this->buffer.clear();
+	}
+
+	template<typename ...Args>
+	void print(fmt::format_string<Args...> format, Args &&...args)
+	{
+		fmt::format_to(std::back_inserter(this->buffer), format, std::forward<Args>(args)...);
+		if (this->buffer.size() >= (1 << 20))
+		{
+			this->flush();
+		}
+	}
+
+	void put(char c)
+	{
+		this->buffer.push_back(c);
+		if (this->buffer.size() >= (1 << 20))
+		{
+			this->flush();
+		}
+	}
+};
+
+struct options_t
+{
+	int day;
+	std::int64_t size;
+	std::int64_t range;
+	std::uint64_t seed;
+	fs::path output_dir;
+};
+
+// size: number of depths, range: unused
+static void generate_day01(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	std::int64_t depth = 100;
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		depth = std::max(std::int64_t(0), depth + rng.uniform(-20, 30));
+		output.print("{}\n", depth);
+	}
+}
+
+// size: number of commands, range: maximum amount
+static void generate_day02(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	constexpr std::array<std::string_view, 3> commands = { "forward", "down", "up" };
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		auto const command = commands[static_cast<std::size_t>(rng.uniform(0, 2))];
+		output.print("{} {}\n", command, rng.uniform(1, std::max(std::int64_t(1), options.range)));
+	}
+}
+
+// size: number of lines, range: bits per line
+static void generate_day03(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.range))
+		{
+			output.put(rng.chance(0.5) ? '1' : '0');
+		}
+		output.put('\n');
+	}
+}
+
+// size: number of boards, range: largest number
+static void generate_day04(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const max_number = std::max(options.range, std::int64_t(24));
+	auto numbers = utils::iota(std::int64_t(0), max_number + 1).collect<vector>();
+	rng.shuffle(numbers);
+	for (auto const &[i, n] : numbers.enumerate())
+	{
+		if (i != 0)
+		{
+			output.put(',');
+		}
+		output.print("{}", n);
+	}
+	output.put('\n');
+
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		// partial shuffle for 25 distinct numbers
+		for (auto const i : utils::iota(std::size_t(0), std::size_t(25)))
+		{
+			std::swap(numbers[i], numbers[static_cast<std::size_t>(rng.uniform(static_cast<std::int64_t>(i), max_number))]);
+		}
+		output.put('\n');
+		for (auto const i : utils::iota(0, 5))
+		{
+			output.print("{:2} {:2} {:2} {:2} {:2}\n", numbers[i * 5], numbers[i * 5 + 1], numbers[i * 5 + 2], numbers[i * 5 + 3], numbers[i * 5 + 4]);
+		}
+	}
+}
+
+// size: number of vents, range: width and height of the grid
+static void generate_day05(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const max_coord = std::max(options.range, std::int64_t(2)) - 1;
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		auto const x1 = rng.uniform(0, max_coord);
+		auto const y1 = rng.uniform(0, max_coord);
+		auto x2 = x1;
+		auto y2 = y1;
+		do
+		{
+			switch (rng.uniform(0, 2))
+			{
+			case 0:
+				x2 = rng.uniform(0, max_coord);
+				break;
+			case 1:
+				y2 = rng.uniform(0, max_coord);
+				break;
+			default:
+			{
+				auto const dx = rng.chance(0.5) ? 1 : -1;
+				auto const dy = rng.chance(0.5) ? 1 : -1;
+				auto const max_length = std::min(dx > 0 ? max_coord - x1 : x1, dy > 0 ? max_coord - y1 : y1);
+				auto const length = rng.uniform(0, max_length);
+				x2 = x1 + dx * length;
+				y2 = y1 + dy * length;
+				break;
+			}
+			}
+		} while (x1 == x2 && y1 == y2);
+		output.print("{},{} -> {},{}\n", x1, y1, x2, y2);
+	}
+}
+
+// size: number of fish, range: unused
+static void generate_day06(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	for (auto const i : utils::iota(std::int64_t(0), options.size))
+	{
+		if (i != 0)
+		{
+			output.put(',');
+		}
+		output.print("{}", rng.uniform(1, 5));
+	}
+	output.put('\n');
+}
+
+// size: number of crabs, range: largest position
+static void generate_day07(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	for (auto const i : utils::iota(std::int64_t(0), options.size))
+	{
+		// skewed towards small positions, like the puzzle input
+		auto const position = rng.uniform(0, rng.uniform(0, options.range));
+		if (i != 0)
+		{
+			output.put(',');
+		}
+		output.print("{}", position);
+	}
+	output.put('\n');
+}
+
+// size: number of entries, range: unused
+static void generate_day08(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	constexpr std::array<std::string_view, 10> digits = {
+		"abcefg", "cf", "acdeg", "acdfg", "bcdf", "abdfg", "abdefg", "acf", "abcdefg", "abcdfg"
+	};
+	std::array<char, 7> wires = { 'a', 'b', 'c', 'd', 'e', 'f', 'g' };
+	std::array<std::size_t, 10> order = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	auto const print_digit = [&](std::size_t digit) {
+		auto segments = string(digits[digit]);
+		for (auto &c : segments)
+		{
+			c = wires[static_cast<std::size_t>(c - 'a')];
+		}
+		rng.shuffle(segments);
+		for (auto const c : segments)
+		{
+			output.put(c);
+		}
+	};
+
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		rng.shuffle(wires);
+		rng.shuffle(order);
+		for (auto const digit : order)
+		{
+			print_digit(digit);
+			output.put(' ');
+		}
+		output.put('|');
+		for ([[maybe_unused]] auto const _ : utils::iota(0, 4))
+		{
+			output.put(' ');
+			print_digit(static_cast<std::size_t>(rng.uniform(0, 9)));
+		}
+		output.put('\n');
+	}
+}
+
+// size: width and height of the heightmap, range: unused
+static void generate_day09(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	for (auto const i : utils::iota(std::int64_t(0), options.size))
+	{
+		for (auto const j : utils::iota(std::int64_t(0), options.size))
+		{
+			// ridges of 9s with some gaps keep the basins small, which keeps the floodfill recursion shallow
+			auto const is_ridge = (i % 8 == 0 || j % 8 == 0) && !rng.chance(0.1);
+			output.put(is_ridge ? '9' : static_cast<char>('0' + rng.uniform(0, 8)));
+		}
+		output.put('\n');
+	}
+}
+
+// size: number of lines, range: maximum line length
+static void generate_day10(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	constexpr std::string_view opening = "([{<";
+	constexpr std::string_view closing = ")]}>";
+	vector<std::size_t> stack;
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		stack.clear();
+		auto const length = rng.uniform(1, std::max(options.range, std::int64_t(1)));
+		auto const is_corrupted = rng.chance(0.5);
+		for (auto const i : utils::iota(std::int64_t(0), length))
+		{
+			if (is_corrupted && i == length - 1 && !stack.empty())
+			{
+				output.put(closing[(stack.back() + 1) % 4]);
+			}
+			else if (stack.empty() || rng.chance(0.6))
+			{
+				auto const paren = static_cast<std::size_t>(rng.uniform(0, 3));
+				stack.push_back(paren);
+				output.put(opening[paren]);
+			}
+			else
+			{
+				output.put(closing[stack.back()]);
+				stack.pop_back();
+			}
+		}
+		if (!is_corrupted && stack.empty())
+		{
+			output.put('(');
+		}
+		output.put('\n');
+	}
+}
+
+// size: width and height of the grid, range: unused
+// large random grids may never flash all at once, which part 2 waits for
+static void generate_day11(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+		{
+			output.put(static_cast<char>('0' + rng.uniform(0, 9)));
+		}
+		output.put('\n');
+	}
+}
+
+// size: number of caves, range: number of extra connections
+// big caves are never connected to each other, otherwise there would be infinitely many paths
+static void generate_day12(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const cave_count = std::max(options.size, std::int64_t(2));
+	auto const cave_name = [](std::int64_t index, bool is_big) {
+		string result;
+		do
+		{
+			result += static_cast<char>((is_big ? 'A' : 'a') + index % 26);
+			index /= 26;
+		} while (index != 0);
+		// make sure the name is never one of the special ones
+		if (!is_big)
+		{
+			result += 'x';
+		}
+		return result;
+	};
+
+	vector<string> names;
+	vector<bool> is_big;
+	names.push_back("start");
+	is_big.push_back(false);
+	for (auto const i : utils::iota(std::int64_t(0), cave_count - 2))
+	{
+		auto const big = i % 4 == 0;
+		names.push_back(cave_name(i, big));
+		is_big.push_back(big);
+	}
+	names.push_back("end");
+	is_big.push_back(false);
+
+	auto const connect = [&](std::size_t a, std::size_t b) {
+		if (a != b && !(is_big[a] && is_big[b]))
+		{
+			output.print("{}-{}\n", names[a], names[b]);
+		}
+	};
+	auto const last_index = static_cast<std::int64_t>(names.size()) - 1;
+	// a spanning tree first, so every cave is reachable
+	for (auto const i : utils::iota(std::int64_t(1), last_index + 1))
+	{
+		auto parent = rng.uniform(0, i - 1);
+		if (is_big[static_cast<std::size_t>(i)] && is_big[static_cast<std::size_t>(parent)])
+		{
+			parent = 0;
+		}
+		connect(static_cast<std::size_t>(parent), static_cast<std::size_t>(i));
+	}
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.range))
+	{
+		connect(static_cast<std::size_t>(rng.uniform(0, last_index)), static_cast<std::size_t>(rng.uniform(0, last_index)));
+	}
+}
+
+// size: number of dots, range: number of folds
+static void generate_day13(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	// the folds are generated backwards from the size of the final code
+	std::int64_t width = 40;
+	std::int64_t height = 6;
+	vector<std::pair<char, std::int64_t>> folds;
+	for (auto const i : utils::iota(std::int64_t(0), options.range))
+	{
+		if (i % 2 == 0)
+		{
+			folds.push_back({ 'x', width });
+			width = 2 * width + 1;
+		}
+		else
+		{
+			folds.push_back({ 'y', height });
+			height = 2 * height + 1;
+		}
+	}
+	std::reverse(folds.begin(), folds.end());
+
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		while (true)
+		{
+			auto const x = rng.uniform(0, width - 1);
+			auto const y = rng.uniform(0, height - 1);
+			// dots can't be on a fold line
+			auto folded_x = x;
+			auto folded_y = y;
+			bool is_on_fold = false;
+			for (auto const &[axis, coord] : folds)
+			{
+				auto &c = axis == 'x' ? folded_x : folded_y;
+				is_on_fold |= c == coord;
+				c = c > coord ? 2 * coord - c : c;
+			}
+			if (!is_on_fold)
+			{
+				output.print("{},{}\n", x, y);
+				break;
+			}
+		}
+	}
+	output.put('\n');
+	for (auto const &[axis, coord] : folds)
+	{
+		output.print("fold along {}={}\n", axis, coord);
+	}
+}
+
+// size: length of the template, range: number of different elements (at most 26)
+static void generate_day14(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const element_count = std::clamp(options.range, std::int64_t(1), std::int64_t(26));
+	auto const random_element = [&]() { return static_cast<char>('A' + rng.uniform(0, element_count - 1)); };
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), std::max(options.size, std::int64_t(2))))
+	{
+		output.put(random_element());
+	}
+	output.print("\n\n");
+	for (auto const first : utils::iota(std::int64_t(0), element_count))
+	{
+		for (auto const second : utils::iota(std::int64_t(0), element_count))
+		{
+			output.print("{}{} -> {}\n", static_cast<char>('A' + first), static_cast<char>('A' + second), random_element());
+		}
+	}
+}
+
+// size: width and height of the map, range: unused
+static void generate_day15(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+		{
+			output.put(static_cast<char>('1' + rng.uniform(0, 8)));
+		}
+		output.put('\n');
+	}
+}
+
+// size: number of packets, range: maximum number of sub-packets of an operator
+static void generate_day16(options_t const &options, rng_t &rng)
+{
+	vector<bool> bits;
+	auto const append = [&bits](std::uint64_t value, int bit_count) {
+		for (int i = bit_count - 1; i >= 0; --i)
+		{
+			bits.push_back(((value >> i) & 1) != 0);
+		}
+	};
+	auto const set_at = [&bits](std::size_t index, std::uint64_t value, int bit_count) {
+		for (int i = 0; i < bit_count; ++i)
+		{
+			bits[index + static_cast<std::size_t>(i)] = ((value >> (bit_count - 1 - i)) & 1) != 0;
+		}
+	};
+
+	auto remaining_packets = std::max(options.size, std::int64_t(1));
+	auto const max_sub_packets = std::max(options.range, std::int64_t(2));
+	auto const write_packet = [&](auto &self, int depth) -> void {
+		remaining_packets -= 1;
+		append(static_cast<std::uint64_t>(rng.uniform(0, 7)), 3);
+		if (remaining_packets <= 0 || depth > 40 || rng.chance(0.4))
+		{
+			append(4, 3);
+			auto groups = rng.uniform(1, 3);
+			for (; groups > 0; --groups)
+			{
+				append(groups == 1 ? 0 : 1, 1);
+				append(static_cast<std::uint64_t>(rng.uniform(0, 15)), 4);
+			}
+			return;
+		}
+
+		auto const type_id = std::array{ 0, 1, 2, 3, 5, 6, 7 }[static_cast<std::size_t>(rng.uniform(0, 6))];
+		append(static_cast<std::uint64_t>(type_id), 3);
+		auto const sub_packet_count = type_id >= 5 ? 2 : rng.uniform(1, std::min(max_sub_packets, std::max(remaining_packets, std::int64_t(1))));
+		if (rng.chance(0.5))
+		{
+			append(0, 1);
+			auto const length_index = bits.size();
+			append(0, 15);
+			auto const begin = bits.size();
+			for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), sub_packet_count))
+			{
+				self(self, depth + 1);
+			}
+			// the length field only has 15 bits
+			assert(bits.size() - begin < (1 << 15));
+			set_at(length_index, bits.size() - begin, 15);
+		}
+		else
+		{
+			append(1, 1);
+			append(static_cast<std::uint64_t>(sub_packet_count), 11);
+			for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), sub_packet_count))
+			{
+				self(self, depth + 1);
+			}
+		}
+	};
+
+	// a sum of packets at the top level, so the length limit of a single operator doesn't apply
+	append(0, 3);
+	append(0, 3);
+	append(1, 1);
+	auto const top_count_index = bits.size();
+	append(0, 11);
+	std::uint64_t top_count = 0;
+	while (remaining_packets > 0 && top_count < 2047)
+	{
+		write_packet(write_packet, 0);
+		top_count += 1;
+	}
+	set_at(top_count_index, top_count, 11);
+
+	while (bits.size() % 4 != 0)
+	{
+		bits.push_back(false);
+	}
+	auto output = output_t(options.output_dir / "input.txt");
+	for (std::size_t i = 0; i < bits.size(); i += 4)
+	{
+		auto const value = (bits[i] << 3) | (bits[i + 1] << 2) | (bits[i + 2] << 1) | bits[i + 3];
+		output.put("0123456789ABCDEF"[value]);
+	}
+	output.put('\n');
+}
+
+// size: distance of the target area, range: unused
+static void generate_day17(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const distance = std::max(options.size, std::int64_t(10));
+	auto const x_begin = rng.uniform(distance, 2 * distance);
+	auto const x_end = x_begin + rng.uniform(1, distance / 4 + 1);
+	auto const y_begin = -rng.uniform(distance / 2, distance);
+	auto const y_end = y_begin + rng.uniform(1, distance / 4 + 1);
+	output.print("target area: x={}..{}, y={}..{}\n", x_begin, x_end, y_begin, std::min(y_end, std::int64_t(-1)));
+}
+
+// size: number of snailfish numbers, range: unused
+static void generate_day18(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const write_element = [&](auto &self, int depth) -> void {
+		if (depth == 4 || (depth > 0 && rng.chance(0.3)))
+		{
+			output.print("{}", rng.uniform(0, 9));
+		}
+		else
+		{
+			output.put('[');
+			self(self, depth + 1);
+			output.put(',');
+			self(self, depth + 1);
+			output.put(']');
+		}
+	};
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		write_element(write_element, 0);
+		output.put('\n');
+	}
+}
+
+// size: number of scanners, range: unused
+static void generate_day19(options_t const &options, rng_t &rng)
+{
+	using vec3 = std::array<std::int64_t, 3>;
+	constexpr std::int64_t scanner_range = 1000;
+	// neighbouring scanners are this far apart along one axis, give or take the jitter, so they see
+	// a slab of each other's cube, and scanners two cells apart see nothing of each other
+	constexpr std::int64_t scanner_spacing = 1100;
+	constexpr std::int64_t scanner_jitter = 60;
+	// the puzzle scanners see 25-27 beacons, 12 of which are shared with a neighbour
+	constexpr std::int64_t beacons_per_scanner = 26;
+	constexpr std::int64_t shared_beacon_count = 12;
+	constexpr int max_beacon_attempts = 1000;
+
+	// the scanners are on the cells of a lattice, along a self avoiding walk, which continues from
+	// a random earlier scanner when it gets stuck, so most scanners have two neighbours
+	// connections[i] is the earlier scanner that scanner i shares beacons with
+	constexpr std::array<vec3, 6> steps = {{ { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } }};
+	auto const scanner_count = static_cast<std::size_t>(std::max(options.size, std::int64_t(1)));
+	vector<vec3> cells = { vec3{ 0, 0, 0 } };
+	vector<std::size_t> connections = { 0 };
+	auto const get_free_neighbours = [&cells, &steps](vec3 const &cell) {
+		return utils::to_range(steps)
+			.transform([&cell](auto const &step) { return vec3{ cell[0] + step[0], cell[1] + step[1], cell[2] + step[2] }; })
+			.filter([&cells](auto const &neighbour) { return !cells.is_any([&neighbour](auto const &c) { return c == neighbour; }); })
+			.collect<vector>();
+	};
+	while (cells.size() < scanner_count)
+	{
+		auto from = cells.size() - 1;
+		auto free_neighbours = get_free_neighbours(cells[from]);
+		while (free_neighbours.empty())
+		{
+			from = static_cast<std::size_t>(rng.uniform(0, static_cast<std::int64_t>(cells.size() - 1)));
+			free_neighbours = get_free_neighbours(cells[from]);
+		}
+		cells.push_back(free_neighbours[static_cast<std::size_t>(rng.uniform(0, static_cast<std::int64_t>(free_neighbours.size() - 1)))]);
+		connections.push_back(from);
+	}
+	auto const scanners = cells
+		.transform([&rng](auto const &cell) {
+			vec3 result;
+			for (auto const axis : utils::iota(0, 3))
+			{
+				result[axis] = cell[axis] * scanner_spacing + rng.uniform(-scanner_jitter, scanner_jitter);
+			}
+			return result;
+		})
+		.collect<vector>();
+
+	auto const is_visible = [](vec3 const &beacon, vec3 const &scanner) {
+		return std::abs(beacon[0] - scanner[0]) <= scanner_range
+			&& std::abs(beacon[1] - scanner[1]) <= scanner_range
+			&& std::abs(beacon[2] - scanner[2]) <= scanner_range;
+	};
+	// a beacon in the cube of the given scanners, which is retried until no other scanner sees it,
+	// so that every scanner sees about beacons_per_scanner beacons
+	vector<vec3> beacons;
+	auto const add_beacon = [&](std::size_t scanner1, std::size_t scanner2) {
+		vec3 beacon;
+		for ([[maybe_unused]] auto const _ : utils::iota(0, max_beacon_attempts))
+		{
+			for (auto const axis : utils::iota(0, 3))
+			{
+				auto const low = std::max(scanners[scanner1][axis], scanners[scanner2][axis]) - scanner_range;
+				auto const high = std::min(scanners[scanner1][axis], scanners[scanner2][axis]) + scanner_range;
+				beacon[axis] = rng.uniform(low, high);
+			}
+			auto const is_seen_by_others = scanners.enumerate().is_any([&](auto const &pair) {
+				auto const &[i, scanner] = pair;
+				return i != scanner1 && i != scanner2 && is_visible(beacon, scanner);
+			});
+			if (!is_seen_by_others)
+			{
+				break;
+			}
+		}
+		beacons.push_back(beacon);
+	};
+
+	vector<std::int64_t> neighbour_counts(scanner_count, 0);
+	for (auto const i : utils::iota(std::size_t(1), scanner_count))
+	{
+		neighbour_counts[i] += 1;
+		neighbour_counts[connections[i]] += 1;
+		for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), shared_beacon_count))
+		{
+			add_beacon(connections[i], i);
+		}
+	}
+	for (auto const i : utils::iota(std::size_t(0), scanner_count))
+	{
+		auto const own_beacon_count = std::max(beacons_per_scanner - shared_beacon_count * neighbour_counts[i], std::int64_t(0));
+		for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), own_beacon_count))
+		{
+			add_beacon(i, i);
+		}
+	}
+
+	// the 24 orientations are the permutations of the axes with sign flips that keep the handedness
+	vector<std::pair<std::array<int, 3>, std::array<int, 3>>> orientations;
+	for (auto axes : { std::array{ 0, 1, 2 }, std::array{ 1, 2, 0 }, std::array{ 2, 0, 1 }, std::array{ 0, 2, 1 }, std::array{ 2, 1, 0 }, std::array{ 1, 0, 2 } })
+	{
+		auto const is_even_permutation = orientations.size() < 12;
+		for (auto const signs : utils::iota(0, 8))
+		{
+			auto const flip_count = std::popcount(static_cast<unsigned>(signs));
+			if ((flip_count % 2 == 0) == is_even_permutation)
+			{
+				orientations.push_back({ axes, { signs & 1 ? -1 : 1, signs & 2 ? -1 : 1, signs & 4 ? -1 : 1 } });
+			}
+		}
+	}
+
+	auto output = output_t(options.output_dir / "input.txt");
+	for (auto const &[i, scanner] : scanners.enumerate())
+	{
+		if (i != 0)
+		{
+			output.put('\n');
+		}
+		output.print("--- scanner {} ---\n", i);
+		// scanner 0 defines the coordinate system
+		auto const &[axes, signs] = orientations[i == 0 ? 0 : static_cast<std::size_t>(rng.uniform(0, 23))];
+		auto visible = beacons
+			.filter([&scanner, &is_visible](auto const &beacon) { return is_visible(beacon, scanner); })
+			.collect<vector>();
+		rng.shuffle(visible);
+		for (auto const &beacon : visible)
+		{
+			output.print(
+				"{},{},{}\n",
+				signs[0] * (beacon[axes[0]] - scanner[axes[0]]),
+				signs[1] * (beacon[axes[1]] - scanner[axes[1]]),
+				signs[2] * (beacon[axes[2]] - scanner[axes[2]])
+			);
+		}
+	}
+}
+
+// size: width and height of the image, range: unused
+static void generate_day20(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto algorithm = utils::iota(0, 512).transform([&](auto const) { return rng.chance(0.5) ? '#' : '.'; }).collect<vector>();
+	// the infinite background has to go dark again after every second step
+	if (algorithm.front() == '#')
+	{
+		algorithm.back() = '.';
+	}
+	for (auto const c : algorithm)
+	{
+		output.put(c);
+	}
+	output.print("\n\n");
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+		{
+			output.put(rng.chance(0.5) ? '#' : '.');
+		}
+		output.put('\n');
+	}
+}
+
+// size: unused, range: unused
+static void generate_day21([[maybe_unused]] options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	output.print("Player 1 starting position: {}\n", rng.uniform(1, 10));
+	output.print("Player 2 starting position: {}\n", rng.uniform(1, 10));
+}
+
+// size: number of instructions, range: largest absolute coordinate
+static void generate_day22(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const range = std::max(options.range, std::int64_t(50));
+	for (auto const i : utils::iota(std::int64_t(0), options.size))
+	{
+		// the first few instructions are in the initialization region, like in the puzzle input
+		auto const is_initialization = i < std::min(options.size / 2, std::int64_t(20));
+		auto const coord_range = is_initialization ? 50 : range;
+		auto const max_size = is_initialization ? 50 : std::max(range / 10, std::int64_t(1));
+		auto const state = i == 0 || rng.chance(0.6);
+		output.print("{} ", state ? "on" : "off");
+		for (auto const axis : utils::iota(0, 3))
+		{
+			auto const begin = rng.uniform(-coord_range, coord_range - 1);
+			auto const end = std::min(begin + rng.uniform(0, max_size), coord_range);
+			output.print("{}{}={}..{}", axis == 0 ? "" : ",", "xyz"[axis], begin, end);
+		}
+		output.put('\n');
+	}
+}
+
+// size: unused, range: unused
+// also writes full_input.txt for part 2
+// the search of part 2 takes minutes for some arrangements, e.g. seed 12
+static void generate_day23([[maybe_unused]] options_t const &options, rng_t &rng)
+{
+	auto amphipods = std::array{ 'A', 'A', 'B', 'B', 'C', 'C', 'D', 'D' };
+	rng.shuffle(amphipods);
+	auto const top = fmt::format("###{}#{}#{}#{}###\n", amphipods[0], amphipods[1], amphipods[2], amphipods[3]);
+	auto const bottom = fmt::format("  #{}#{}#{}#{}#\n", amphipods[4], amphipods[5], amphipods[6], amphipods[7]);
+	{
+		auto output = output_t(options.output_dir / "input.txt");
+		output.print("#############\n#...........#\n{}{}  #########\n", top, bottom);
+	}
+	{
+		auto output = output_t(options.output_dir / "full_input.txt");
+		output.print("#############\n#...........#\n{}  #D#C#B#A#\n  #D#B#A#C#\n{}  #########\n", top, bottom);
+	}
+}
+
+// size: width and height of the seafloor, range: percentage of occupied spaces
+// large random seafloors aren't guaranteed to ever stop moving
+static void generate_day25(options_t const &options, rng_t &rng)
+{
+	auto output = output_t(options.output_dir / "input.txt");
+	auto const density = static_cast<double>(std::clamp(options.range, std::int64_t(0), std::int64_t(100))) / 100.0;
+	for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+	{
+		for ([[maybe_unused]] auto const _ : utils::iota(std::int64_t(0), options.size))
+		{
+			output.put(!rng.chance(density) ? '.' : rng.chance(0.5) ? '>' : 'v');
+		}
+		output.put('\n');
+	}
+}
+
+struct generator_t
+{
+	void (*generate)(options_t const &options, rng_t &rng);
+	std::int64_t default_size;
+	std::int64_t default_range;
+};
+
+// the defaults are about the size of the puzzle inputs
+static constexpr std::array<generator_t, 26> generators = {{
+	{ nullptr, 0, 0 },
+	{ &generate_day01, 2000, 0 },
+	{ &generate_day02, 1000, 9 },
+	{ &generate_day03, 1000, 12 },
+	{ &generate_day04, 100, 99 },
+	{ &generate_day05, 500, 1000 },
+	{ &generate_day06, 300, 0 },
+	{ &generate_day07, 1000, 2000 },
+	{ &generate_day08, 200, 0 },
+	{ &generate_day09, 100, 0 },
+	{ &generate_day10, 100, 110 },
+	{ &generate_day11, 10, 0 },
+	{ &generate_day12, 12, 10 },
+	{ &generate_day13, 800, 12 },
+	{ &generate_day14, 20, 10 },
+	{ &generate_day15, 100, 0 },
+	{ &generate_day16, 60, 5 },
+	{ &generate_day17, 200, 0 },
+	{ &generate_day18, 100, 0 },
+	{ &generate_day19, 30, 0 },
+	{ &generate_day20, 100, 0 },
+	{ &generate_day21, 0, 0 },
+	{ &generate_day22, 420, 100000 },
+	{ &generate_day23, 0, 0 },
+	{ nullptr, 0, 0 },
+	{ &generate_day25, 137, 60 },
+}};
+
+static void print_usage(void)
+{
+	fmt::print(stderr,
+		"usage: aoc_gen -d <day> -o <dir> [options]\n"
+		"  -d <day>     day to generate the input for (1-25, except 24)\n"
+		"  -o <dir>     output directory, input.txt is written there\n"
+		"  -n <size>    size of the input, e.g. number of lines or width of a grid (default: puzzle size)\n"
+		"  -w <range>   value range of the input, e.g. grid size of day 5 or bits of day 3 (default: puzzle range)\n"
+		"  -s <seed>    seed of the random generator (default 0)\n"
+		"the meaning of -n and -w for each day is documented in bench/generate.cpp\n"
+	);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	options_t options{ 0, -1, -1, 0, fs::path() };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		auto const arg = std::string_view(argv[i]);
+		if (i + 1 == argc || arg.size() != 2 || arg[0] != '-')
+		{
+			print_usage();
+			return 1;
+		}
+		auto const value = std::string_view(argv[++i]);
+		switch (arg[1])
+		{
+		case 'd':
+			options.day = parse_int<int>(value);
+			break;
+		case 'o':
+			options.output_dir = value;
+			break;
+		case 'n':
+			options.size = parse_int<std::int64_t>(value);
+			break;
+		case 'w':
+			options.range = parse_int<std::int64_t>(value);
+			break;
+		case 's':
+			options.seed = parse_int<std::uint64_t>(value);
+			break;
+		default:
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (
+		options.day < 1 || options.day >= static_cast<int>(generators.size())
+		|| generators[static_cast<std::size_t>(options.day)].generate == nullptr
+		|| options.output_dir.empty()
+	)
+	{
+		print_usage();
+		return 1;
+	}
+
+	auto const &generator = generators[static_cast<std::size_t>(options.day)];
+	options.size = options.size < 0 ? generator.default_size : options.size;
+	options.range = options.range < 0 ? generator.default_range : options.range;
+
+	fs::create_directories(options.output_dir);
+	// every day gets a different sequence from the same seed
+	auto rng = rng_t(options.seed * 32 + static_cast<std::uint64_t>(options.day));
+	generator.generate(options, rng);
+	return 0;
+}
@@ -0,0 +1,255 @@
+#include "common.h"
+#include "bench/bench.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// every allocation in the process goes through these, so the solutions' allocations can be counted
+static std::atomic<std::size_t> allocation_count = 0;
+static std::atomic<std::size_t> allocated_bytes = 0;
+
+static void *allocate(std::size_t size, std::size_t alignment)
+{
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	size = size == 0 ? 1 : size;
+#if defined(_WIN32)
+	auto const result = _aligned_malloc(size, alignment);
+#else
+	auto const result = alignment <= alignof(std::max_align_t)
+		? std::malloc(size)
+		: std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	if (result == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+static void deallocate(void *ptr) noexcept
+{
+#if defined(_WIN32)
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+void *operator new (std::size_t size)
+{ return allocate(size, alignof(std::max_align_t)); }
+
+void *operator new (std::size_t size, std::align_val_t alignment)
+{ return allocate(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete (void *ptr) noexcept
+{ deallocate(ptr); }
+
+void operator delete (void *ptr, std::size_t) noexcept
+{ deallocate(ptr); }
+
+void operator delete (void *ptr, std::align_val_t) noexcept
+{ deallocate(ptr); }
+
+void operator delete (void *ptr, std::size_t, std::align_val_t) noexcept
+{ deallocate(ptr); }
+
+// resets the peak resident set size of the process, if the platform allows it
+static void reset_peak_rss(void)
+{
+#if defined(__linux__)
+	auto file = std::ofstream("/proc/self/clear_refs");
+	file << "5";
+#endif
+}
+
+// peak resident set size of the process in KiB
+static std::size_t get_peak_rss_kib(void)
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters{};
+	K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters);
+	return counters.PeakWorkingSetSize / 1024;
+#else
+#if defined(__linux__)
+	// VmHWM is affected by reset_peak_rss, unlike ru_maxrss
+	auto file = std::ifstream("/proc/self/status");
+	string line;
+	while (std::getline(file, line))
+	{
+		if (line.starts_with("VmHWM:"))
+		{
+			return parse_int<std::size_t>(std::string_view(line).substr(line.find_first_not_of(" \t", 6)));
+		}
+	}
+#endif
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+	return static_cast<std::size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+struct part_result_t
+{
+	int day;
+	int part;
+	string input;
+	std::uint64_t min_ns;
+	std::uint64_t median_ns;
+	std::uint64_t p99_ns;
+	std::size_t peak_rss_kib;
+	// averages over the timed runs
+	double allocations;
+	double allocated_bytes;
+};
+
+static part_result_t run_part(int day, int part, fs::path const &input, std::function<void()> const &run, std::size_t iterations)
+{
+	// one untimed run to warm up the caches and the allocator
+	run();
+
+	vector<std::uint64_t> times;
+	times.reserve(iterations);
+
+	reset_peak_rss();
+	auto const allocation_count_before = allocation_count.load();
+	auto const allocated_bytes_before = allocated_bytes.load();
+	for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), iterations))
+	{
+		auto const begin = std::chrono::steady_clock::now();
+		run();
+		auto const end = std::chrono::steady_clock::now();
+		times.push_back(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+	}
+
+	auto const allocation_count_after = allocation_count.load();
+	auto const allocated_bytes_after = allocated_bytes.load();
+	auto const peak_rss_kib = get_peak_rss_kib();
+
+	times.sort();
+	auto const p99_index = (times.size() * 99 + 99) / 100 - 1;
+	return part_result_t{
+		day, part, input.generic_string(),
+		times.front(), times[times.size() / 2], times[p99_index],
+		peak_rss_kib,
+		static_cast<double>(allocation_count_after - allocation_count_before) / static_cast<double>(iterations),
+		static_cast<double>(allocated_bytes_after - allocated_bytes_before) / static_cast<double>(iterations),
+	};
+}
+
+static void print_usage(void)
+{
+	fmt::print(stderr,
+		"usage: aoc_bench [options]\n"
+		"  -n <count>   number of timed runs of each part (default 10)\n"
+		"  -d <day>     only run the given day (default all days)\n"
+		"  -i <file>    input file, only valid together with -d (default dayNN/input.txt)\n"
+		"  -r <dir>     directory containing the dayNN directories (default .)\n"
+	);
+}
+
+int main(int argc, char **argv)
+{
+	std::size_t iterations = 10;
+	int selected_day = 0;
+	fs::path input_file;
+	fs::path root_dir = ".";
+
+	for (int i = 1; i < argc; ++i)
+	{
+		auto const arg = std::string_view(argv[i]);
+		if (i + 1 == argc || arg.size() != 2 || arg[0] != '-')
+		{
+			print_usage();
+			return 1;
+		}
+		auto const value = std::string_view(argv[++i]);
+		switch (arg[1])
+		{
+		case 'n':
+			iterations = parse_int<std::size_t>(value);
+			break;
+		case 'd':
+			selected_day = parse_int<int>(value);
+			break;
+		case 'i':
+			input_file = value;
+			break;
+		case 'r':
+			root_dir = value;
+			break;
+		default:
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (iterations == 0 || (!input_file.empty() && selected_day == 0))
+	{
+		print_usage();
+		return 1;
+	}
+
+	auto &days = bench::days();
+	days.sort([](auto const &lhs, auto const &rhs) { return lhs.number < rhs.number; });
+
+	vector<part_result_t> results;
+	for (auto const &day : days)
+	{
+		if (selected_day != 0 && day.number != selected_day)
+		{
+			continue;
+		}
+
+		auto const input = input_file.empty()
+			? root_dir / fmt::format("day{:02}", day.number) / "input.txt"
+			: input_file;
+		if (!fs::exists(input))
+		{
+			fmt::print(stderr, "error: input file '{}' doesn't exist\n", input.generic_string());
+			return 1;
+		}
+
+		auto const parts = day.load(input);
+		for (auto const part_index : utils::iota(0, 2))
+		{
+			if (parts[part_index])
+			{
+				results.push_back(run_part(day.number, part_index + 1, input, parts[part_index], iterations));
+			}
+		}
+	}
+
+	if (selected_day != 0 && results.empty())
+	{
+		fmt::print(stderr, "error: day {} is not available\n", selected_day);
+		return 1;
+	}
+
+	fmt::print("{{\n  \"iterations\": {},\n  \"results\": [", iterations);
+	for (auto const &[index, result] : results.enumerate())
+	{
+		fmt::print(
+			"{}\n    {{ \"day\": {}, \"part\": {}, \"input\": \"{}\", \"min_ns\": {}, \"median_ns\": {}, \"p99_ns\": {}, "
+			"\"peak_rss_kib\": {}, \"allocations\": {}, \"allocated_bytes\": {} }}",
+			index == 0 ? "" : ",",
+			result.day, result.part, result.input,
+			result.min_ns, result.median_ns, result.p99_ns,
+			result.peak_rss_kib, result.allocations, result.allocated_bytes
+		);
+	}
+	fmt::print("\n  ]\n}}\n");
+
+	return 0;
+}
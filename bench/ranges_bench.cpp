@@ -0,0 +1,155 @@
+#include "common.h"
+#include "bench/bench.h"
+#include <chrono>
+
+// throughput of range pipelines that sum lowers to an indexed loop, compared to the
+// same pipelines iterated with operator ++ and at_end
+// build with AOC_NATIVE to get the AVX2 code
+
+namespace
+{
+
+// sums a range through its iterator interface, like sum did before the indexed loops
+template<typename Range>
+static auto iterator_sum(Range const &range)
+{
+	std::decay_t<decltype(*range)> result{};
+	for (auto &&value : range)
+	{
+		result += value;
+	}
+	return result;
+}
+
+struct result_t
+{
+	std::string_view name;
+	double iterator_ns_per_element;
+	double indexed_ns_per_element;
+};
+
+template<typename Func>
+static double measure_ns_per_element(std::size_t element_count, std::size_t iterations, Func &&func)
+{
+	bench::do_not_optimize(func());
+	auto best = std::chrono::nanoseconds::max();
+	for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), iterations))
+	{
+		auto const begin = std::chrono::steady_clock::now();
+		bench::do_not_optimize(func());
+		auto const end = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin));
+	}
+	return static_cast<double>(best.count()) / static_cast<double>(element_count);
+}
+
+template<typename MakeRange>
+static result_t run(std::string_view name, std::size_t element_count, std::size_t iterations, MakeRange &&make_range)
+{
+	auto const iterator_result = iterator_sum(make_range());
+	auto const indexed_result = make_range().sum();
+	if (iterator_result != indexed_result)
+	{
+		fmt::print(stderr, "error: different results for '{}': {} and {}\n", name, iterator_result, indexed_result);
+		std::exit(1);
+	}
+
+	return result_t{
+		name,
+		measure_ns_per_element(element_count, iterations, [&]() { return iterator_sum(make_range()); }),
+		measure_ns_per_element(element_count, iterations, [&]() { return make_range().sum(); }),
+	};
+}
+
+static void print_usage(void)
+{
+	fmt::print(stderr,
+		"usage: aoc_ranges_bench [options]\n"
+		"  -n <count>   number of elements (default 1048576)\n"
+		"  -i <count>   number of timed runs, the fastest one is reported (default 20)\n"
+	);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	std::size_t element_count = 1 << 20;
+	std::size_t iterations = 20;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		auto const arg = std::string_view(argv[i]);
+		if (i + 1 == argc || arg.size() != 2 || arg[0] != '-')
+		{
+			print_usage();
+			return 1;
+		}
+		auto const value = std::string_view(argv[++i]);
+		switch (arg[1])
+		{
+		case 'n':
+			element_count = parse_int<std::size_t>(value);
+			break;
+		case 'i':
+			iterations = parse_int<std::size_t>(value);
+			break;
+		default:
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (element_count < 3 || iterations == 0)
+	{
+		print_usage();
+		return 1;
+	}
+
+	// a fixed pseudo-random sequence, so the runs are comparable
+	vector<int> data;
+	data.reserve(element_count);
+	std::uint32_t state = 12345;
+	for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), element_count))
+	{
+		state = state * 1664525 + 1013904223;
+		data.push_back(static_cast<int>(state >> 22));
+	}
+	auto const values = span<int const>(data);
+
+	vector<result_t> results;
+	// day 1 part 1
+	results.push_back(run("adjacent().transform().sum()", element_count, iterations, [values]() {
+		return values.adjacent().transform([](auto const pair) { return pair.second > pair.first ? 1 : 0; });
+	}));
+	// day 1 part 2
+	results.push_back(run("running_sum<3>().adjacent().transform().sum()", element_count, iterations, [values]() {
+		return values.running_sum<3>().adjacent().transform([](auto const pair) { return pair.second > pair.first ? 1 : 0; });
+	}));
+	// day 5
+	results.push_back(run("transform().sum()", element_count, iterations, [values]() {
+		return values.transform([](auto const n) { return n >= 512 ? 1 : 0; });
+	}));
+	results.push_back(run("filter().sum()", element_count, iterations, [values]() {
+		return values.filter([](auto const n) { return n % 2 == 0; });
+	}));
+	// iota sources stay on the iterator path, so both forms are the same loop here
+	results.push_back(run("iota().transform().sum()", element_count, iterations, [element_count]() {
+		return utils::iota(0, static_cast<int>(element_count)).transform([](auto const n) { return n & 0xff; });
+	}));
+
+	fmt::print("{{\n  \"elements\": {},\n  \"results\": [", element_count);
+	for (auto const &[index, result] : results.enumerate())
+	{
+		fmt::print(
+			"{}\n    {{ \"pipeline\": \"{}\", \"iterator_ns_per_element\": {:.4f}, \"indexed_ns_per_element\": {:.4f}, \"speedup\": {:.2f} }}",
+			index == 0 ? "" : ",",
+			result.name,
+			result.iterator_ns_per_element, result.indexed_ns_per_element,
+			result.iterator_ns_per_element / result.indexed_ns_per_element
+		);
+	}
+	fmt::print("\n  ]\n}}\n");
+
+	return 0;
+}
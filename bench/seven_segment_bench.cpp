@@ -0,0 +1,207 @@
+#include "common.h"
+#include "bench/bench.h"
+#include "day08/src/seven_segment.h"
+#include <array>
+#include <chrono>
+
+// day 8 display decoding: seven_segment::wiring_table_t, which decodes a display with one lookup,
+// compared to the swap cascade that sorted the signal patterns of every display by their digits
+
+namespace
+{
+
+struct display_t
+{
+	std::array<std::uint8_t, seven_segment::digit_count> signal_patterns;
+	std::array<std::uint8_t, 4> output_value;
+};
+
+// the previous solution: the patterns are swapped into the index of their digit, using the
+// segment counts and the overlaps with the patterns that are already found
+static std::uint64_t swap_cascade_decode(display_t display)
+{
+	auto &signal_patterns = display.signal_patterns;
+	auto const move_first = [&signal_patterns](std::size_t digit, std::initializer_list<std::size_t> indices, auto &&is_digit) {
+		for (auto const i : indices)
+		{
+			if (is_digit(signal_patterns[i]))
+			{
+				std::swap(signal_patterns[i], signal_patterns[digit]);
+				break;
+			}
+		}
+	};
+	auto const has_segment_count = [](int count) {
+		return [count](std::uint8_t pattern) { return std::popcount(pattern) == count; };
+	};
+	auto const all_indices = std::initializer_list<std::size_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+	// 1, 4, 7 and 8 by their unique segment counts
+	move_first(1, all_indices, has_segment_count(2));
+	move_first(4, all_indices, has_segment_count(4));
+	move_first(7, all_indices, has_segment_count(3));
+	move_first(8, all_indices, has_segment_count(7));
+	// only 8 and 9 contain 4 | 7
+	auto const unique_9 = static_cast<std::uint8_t>(signal_patterns[4] | signal_patterns[7]);
+	move_first(9, { 0, 2, 3, 5, 6, 9 }, [unique_9](std::uint8_t pattern) { return (pattern & unique_9) == unique_9; });
+	// only 5, 6, 8 and 9 contain 9 & ~1, and 5 and 6 have different segment counts
+	auto const unique_56 = static_cast<std::uint8_t>(signal_patterns[9] & ~signal_patterns[1]);
+	move_first(5, { 0, 2, 3, 5, 6 }, [unique_56](std::uint8_t pattern) {
+		return (pattern & unique_56) == unique_56 && std::popcount(pattern) == 5;
+	});
+	move_first(6, { 0, 2, 3, 6 }, [unique_56](std::uint8_t pattern) { return (pattern & unique_56) == unique_56; });
+	// 0 has 6 segments
+	move_first(0, { 0, 2, 3 }, has_segment_count(6));
+	// 3 contains 1, 2 doesn't
+	if ((signal_patterns[3] & signal_patterns[1]) != signal_patterns[1])
+	{
+		std::swap(signal_patterns[2], signal_patterns[3]);
+	}
+
+	std::uint64_t result = 0;
+	for (auto const pattern : display.output_value)
+	{
+		auto const digit = std::find(signal_patterns.begin(), signal_patterns.end(), pattern) - signal_patterns.begin();
+		result = result * 10 + static_cast<std::uint64_t>(digit);
+	}
+	return result;
+}
+
+static std::uint64_t swap_cascade_sum(span<display_t const> displays)
+{
+	return displays
+		.transform([](auto const &display) { return swap_cascade_decode(display); })
+		.sum();
+}
+
+static std::uint64_t wiring_table_sum(seven_segment::wiring_table_t const &wiring_table, span<display_t const> displays)
+{
+	return displays
+		.transform([&wiring_table](auto const &display) {
+			return wiring_table.decode(display.signal_patterns, display.output_value);
+		})
+		.sum();
+}
+
+template<typename Func>
+static double measure_ns(std::size_t iterations, Func &&func)
+{
+	bench::do_not_optimize(func());
+	auto best = std::chrono::nanoseconds::max();
+	for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), iterations))
+	{
+		auto const begin = std::chrono::steady_clock::now();
+		bench::do_not_optimize(func());
+		auto const end = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin));
+	}
+	return static_cast<double>(best.count());
+}
+
+static void print_usage(void)
+{
+	fmt::print(stderr,
+		"usage: aoc_seven_segment_bench [options]\n"
+		"  -n <count>   number of displays (default 10000000)\n"
+		"  -i <count>   number of timed runs, the fastest one is reported (default 5)\n"
+	);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	std::size_t display_count = 10'000'000;
+	std::size_t iterations = 5;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		auto const arg = std::string_view(argv[i]);
+		if (i + 1 == argc || arg.size() != 2 || arg[0] != '-')
+		{
+			print_usage();
+			return 1;
+		}
+		auto const value = std::string_view(argv[++i]);
+		switch (arg[1])
+		{
+		case 'n':
+			display_count = parse_int<std::size_t>(value);
+			break;
+		case 'i':
+			iterations = parse_int<std::size_t>(value);
+			break;
+		default:
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (display_count == 0 || iterations == 0)
+	{
+		print_usage();
+		return 1;
+	}
+
+	// random wirings and orders like the puzzle input, with a fixed seed so the runs are comparable
+	std::uint32_t state = 12345;
+	auto const random_below = [&state](std::size_t bound) {
+		state = state * 1664525 + 1013904223;
+		return static_cast<std::size_t>((std::uint64_t(state) * bound) >> 32);
+	};
+	auto const shuffle = [&random_below](auto &values) {
+		for (std::size_t i = values.size(); i > 1; --i)
+		{
+			std::swap(values[i - 1], values[random_below(i)]);
+		}
+	};
+	vector<display_t> displays;
+	displays.reserve(display_count);
+	std::array<std::uint8_t, seven_segment::segment_count> wires = { 0, 1, 2, 3, 4, 5, 6 };
+	auto const scramble = [&wires](std::uint8_t pattern) {
+		std::uint8_t result = 0;
+		for (auto const segment : utils::iota(std::size_t(0), seven_segment::segment_count))
+		{
+			result |= static_cast<std::uint8_t>(((pattern >> segment) & 1) << wires[segment]);
+		}
+		return result;
+	};
+	for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), display_count))
+	{
+		shuffle(wires);
+		display_t display;
+		for (auto const digit : utils::iota(std::size_t(0), seven_segment::digit_count))
+		{
+			display.signal_patterns[digit] = scramble(seven_segment::digit_patterns[digit]);
+		}
+		shuffle(display.signal_patterns);
+		for (auto &pattern : display.output_value)
+		{
+			pattern = scramble(seven_segment::digit_patterns[random_below(seven_segment::digit_count)]);
+		}
+		displays.push_back(display);
+	}
+
+	auto const build_ns = measure_ns(iterations, []() { return seven_segment::wiring_table_t(); });
+	auto const wiring_table = seven_segment::wiring_table_t();
+
+	auto const swap_cascade_result = swap_cascade_sum(displays);
+	auto const wiring_table_result = wiring_table_sum(wiring_table, displays);
+	if (swap_cascade_result != wiring_table_result)
+	{
+		fmt::print(stderr, "error: different results: {} and {}\n", swap_cascade_result, wiring_table_result);
+		return 1;
+	}
+
+	auto const swap_cascade_ns = measure_ns(iterations, [&]() { return swap_cascade_sum(displays); });
+	auto const wiring_table_ns = measure_ns(iterations, [&]() { return wiring_table_sum(wiring_table, displays); });
+
+	fmt::print(
+		"{{\n  \"displays\": {},\n  \"table_build_ms\": {:.3f},\n"
+		"  \"swap_cascade_ms\": {:.3f},\n  \"wiring_table_ms\": {:.3f},\n  \"speedup\": {:.1f}\n}}\n",
+		display_count, build_ns / 1e6,
+		swap_cascade_ns / 1e6, wiring_table_ns / 1e6, swap_cascade_ns / wiring_table_ns
+	);
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+#include "common.h"
+#include "bench/bench.h"
+#include "day01/src/sonar.h"
+#include <chrono>
+
+// day 1 increase counts for many window sizes: sonar::count_increases for all window sizes in one pass,
+// compared to a running_sum<N>().adjacent() pipeline for each window size
+// build with AOC_NATIVE to get the AVX2 code
+
+namespace
+{
+
+// running_sum needs the window size at compile time, so the compared window sizes are fixed
+using window_sizes_t = std::index_sequence<1, 2, 3, 4, 8, 16, 32, 64, 128, 256, 512, 1024>;
+
+template<std::size_t N>
+static std::size_t running_sum_increases(span<int const> depths)
+{
+	return depths
+		.running_sum<N>()
+		.adjacent()
+		.transform([](auto const pair) -> std::size_t { return pair.second > pair.first ? 1 : 0; })
+		.sum();
+}
+
+template<std::size_t ...Ns>
+static vector<std::size_t> running_sum_increases(span<int const> depths, std::index_sequence<Ns...>)
+{
+	return vector<std::size_t>{ running_sum_increases<Ns>(depths)... };
+}
+
+template<std::size_t ...Ns>
+static vector<std::size_t> to_vector(std::index_sequence<Ns...>)
+{
+	return vector<std::size_t>{ Ns... };
+}
+
+template<typename Func>
+static double measure_ns(std::size_t iterations, Func &&func)
+{
+	bench::do_not_optimize(func());
+	auto best = std::chrono::nanoseconds::max();
+	for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), iterations))
+	{
+		auto const begin = std::chrono::steady_clock::now();
+		bench::do_not_optimize(func());
+		auto const end = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin));
+	}
+	return static_cast<double>(best.count());
+}
+
+static void print_usage(void)
+{
+	fmt::print(stderr,
+		"usage: aoc_sonar_bench [options]\n"
+		"  -n <count>   number of depths (default 1048576)\n"
+		"  -i <count>   number of timed runs, the fastest one is reported (default 5)\n"
+	);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	std::size_t depth_count = 1 << 20;
+	std::size_t iterations = 5;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		auto const arg = std::string_view(argv[i]);
+		if (i + 1 == argc || arg.size() != 2 || arg[0] != '-')
+		{
+			print_usage();
+			return 1;
+		}
+		auto const value = std::string_view(argv[++i]);
+		switch (arg[1])
+		{
+		case 'n':
+			depth_count = parse_int<std::size_t>(value);
+			break;
+		case 'i':
+			iterations = parse_int<std::size_t>(value);
+			break;
+		default:
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (depth_count == 0 || iterations == 0)
+	{
+		print_usage();
+		return 1;
+	}
+
+	// a random walk like the puzzle input, with a fixed seed so the runs are comparable
+	vector<int> data;
+	data.reserve(depth_count);
+	std::uint32_t state = 12345;
+	int depth = 1000;
+	for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), depth_count))
+	{
+		state = state * 1664525 + 1013904223;
+		depth = std::max(depth + static_cast<int>(state >> 28) - 7, 0);
+		data.push_back(depth);
+	}
+	auto const depths = span<int const>(data);
+	auto const window_sizes = to_vector(window_sizes_t{});
+
+	auto const engine_counts = sonar::count_increases(depths, window_sizes);
+	auto const running_sum_counts = running_sum_increases(depths, window_sizes_t{});
+	for (auto const &[index, window_size] : window_sizes.enumerate())
+	{
+		if (engine_counts[index] != running_sum_counts[index])
+		{
+			fmt::print(
+				stderr, "error: different results for window size {}: {} and {}\n",
+				window_size, running_sum_counts[index], engine_counts[index]
+			);
+			return 1;
+		}
+	}
+
+	auto const engine_ns = measure_ns(iterations, [&]() { return sonar::count_increases(depths, window_sizes); });
+	auto const running_sum_ns = measure_ns(iterations, [&]() { return running_sum_increases(depths, window_sizes_t{}); });
+	// every window size separately, without the blocking over the window sizes
+	auto const single_window_ns = measure_ns(iterations, [&]() {
+		return window_sizes.transform([depths](auto const window_size) { return sonar::count_increases(depths, window_size); }).sum();
+	});
+	// all window sizes up to the largest one
+	auto const all_window_sizes = utils::iota(std::size_t(1), window_sizes.back() + 1).collect<vector>();
+	auto const all_windows_ns = measure_ns(iterations, [&]() { return sonar::count_increases(depths, all_window_sizes); });
+
+	fmt::print(
+		"{{\n  \"depths\": {},\n  \"window_sizes\": {},\n"
+		"  \"running_sum_ms\": {:.3f},\n  \"engine_ms\": {:.3f},\n  \"engine_unblocked_ms\": {:.3f},\n  \"speedup\": {:.1f},\n"
+		"  \"all_{}_window_sizes_ms\": {:.3f}\n}}\n",
+		depth_count, window_sizes.size(),
+		running_sum_ns / 1e6, engine_ns / 1e6, single_window_ns / 1e6, running_sum_ns / engine_ns,
+		all_window_sizes.size(), all_windows_ns / 1e6
+	);
+
+	return 0;
+}
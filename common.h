@@ -12,6 +12,43 @@
 #include <fstream>
 #include <cassert>
 #include <span>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+#include <thread>
+#include <memory>
+#include <optional>
+#include <cerrno>
+
+#if defined(__AVX2__)
+#define AOC_HAS_AVX2 1
+#define AOC_HAS_SSE4_1 1
+#elif defined(__SSE4_1__)
+#define AOC_HAS_AVX2 0
+#define AOC_HAS_SSE4_1 1
+#else
+#define AOC_HAS_AVX2 0
+#define AOC_HAS_SSE4_1 0
+#endif
+
+#if AOC_HAS_SSE4_1
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -58,6 +95,12 @@ struct string : std::string, utils::collection_base<string>
 	using std::string::string;
 };
 
+struct string_view : std::string_view, utils::collection_base<string_view>
+{
+	string_view(std::string_view str) : std::string_view(str) {}
+	using std::string_view::basic_string_view;
+};
+
 template<typename Key, typename Value>
 struct unordered_map : std::unordered_map<Key, Value>, utils::collection_base<unordered_map<Key, Value>>
 {
@@ -65,6 +108,166 @@ struct unordered_map : std::unordered_map<Key, Value>, utils::collection_base<un
 	using std::unordered_map<Key, Value>::contains;
 };
 
+namespace internal
+{
+
+template<typename Int>
+constexpr bool is_fast_parse_int_v = std::is_integral_v<Int> && sizeof (Int) <= sizeof (std::uint64_t);
+
+// number of decimal digits at the start of [it, end)
+inline std::size_t count_digits(char const *it, char const *end) noexcept
+{
+	auto const begin = it;
+#if AOC_HAS_AVX2
+	while (end - it >= 32)
+	{
+		auto const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(it));
+		auto const is_digit = _mm256_and_si256(
+			_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8('0' - 1)),
+			_mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chunk)
+		);
+		auto const non_digit_mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(is_digit));
+		if (non_digit_mask != 0)
+		{
+			return static_cast<std::size_t>(it - begin) + std::countr_zero(non_digit_mask);
+		}
+		it += 32;
+	}
+#endif
+#if AOC_HAS_SSE4_1
+	while (end - it >= 16)
+	{
+		auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(it));
+		auto const is_digit = _mm_and_si128(
+			_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+			_mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1))
+		);
+		auto const non_digit_mask = ~static_cast<std::uint32_t>(_mm_movemask_epi8(is_digit)) & 0xffff;
+		if (non_digit_mask != 0)
+		{
+			return static_cast<std::size_t>(it - begin) + std::countr_zero(non_digit_mask);
+		}
+		it += 16;
+	}
+#endif
+	while (it != end && *it >= '0' && *it <= '9')
+	{
+		++it;
+	}
+	return static_cast<std::size_t>(it - begin);
+}
+
+// loads 1 to 8 characters into the high bytes of a little endian word, with the missing
+// leading characters filled with fill_char
+inline std::uint64_t load_up_to_8(char const *it, std::size_t n, char fill_char) noexcept
+{
+	assert(n >= 1 && n <= 8);
+	char buffer[8];
+	std::memset(buffer, fill_char, 8);
+	std::memcpy(buffer + (8 - n), it, n);
+	std::uint64_t result;
+	std::memcpy(&result, buffer, 8);
+	return result;
+}
+
+// value of 8 decimal digits packed in a little endian word, first digit in the lowest byte
+inline std::uint64_t parse_8_digits(std::uint64_t chars) noexcept
+{
+	chars -= 0x3030'3030'3030'3030;
+	chars = (chars * 10 + (chars >> 8)) & 0x00ff'00ff'00ff'00ff;
+	chars = (chars * 100 + (chars >> 16)) & 0x0000'ffff'0000'ffff;
+	chars = (chars * 10000 + (chars >> 32)) & 0x0000'0000'ffff'ffff;
+	return chars;
+}
+
+#if AOC_HAS_SSE4_1
+inline std::uint64_t parse_16_digits(char const *it) noexcept
+{
+	auto const digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(it)), _mm_set1_epi8('0'));
+	auto const pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+	auto const quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+	auto const quads_16 = _mm_packus_epi32(quads, quads);
+	auto const octs = _mm_madd_epi16(quads_16, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+	auto const high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(octs));
+	auto const low = static_cast<std::uint32_t>(_mm_extract_epi32(octs, 1));
+	return std::uint64_t(high) * 100'000'000 + low;
+}
+#endif
+
+// value of the n decimal digits starting at it, wrapping around on overflow
+inline std::uint64_t parse_decimal_digits(char const *it, std::size_t n) noexcept
+{
+	if constexpr (std::endian::native != std::endian::little)
+	{
+		std::uint64_t result = 0;
+		for (auto const c : std::string_view(it, n))
+		{
+			result = result * 10 + std::uint64_t(c - '0');
+		}
+		return result;
+	}
+
+	std::uint64_t result = 0;
+#if AOC_HAS_SSE4_1
+	for (; n >= 16; it += 16, n -= 16)
+	{
+		result = result * 10'000'000'000'000'000 + parse_16_digits(it);
+	}
+#endif
+	for (; n >= 8; it += 8, n -= 8)
+	{
+		std::uint64_t chars;
+		std::memcpy(&chars, it, 8);
+		result = result * 100'000'000 + parse_8_digits(chars);
+	}
+	// short tails are faster digit by digit than through the 8 byte load
+	for (; n != 0; ++it, --n)
+	{
+		result = result * 10 + std::uint64_t(*it - '0');
+	}
+	return result;
+}
+
+// value of the n binary digits starting at it, first digit being the most significant
+inline std::uint64_t parse_binary_digits(char const *it, std::size_t n) noexcept
+{
+	if constexpr (std::endian::native != std::endian::little)
+	{
+		std::uint64_t result = 0;
+		for (auto const c : std::string_view(it, n))
+		{
+			result = (result << 1) | std::uint64_t(c & 1);
+		}
+		return result;
+	}
+
+	std::uint64_t result = 0;
+#if AOC_HAS_SSE4_1
+	for (; n >= 16; it += 16, n -= 16)
+	{
+		auto const chars = _mm_loadu_si128(reinterpret_cast<__m128i const *>(it));
+		// reverse the bytes, so the first character ends up in the highest bit of the mask
+		auto const reversed = _mm_shuffle_epi8(chars, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+		auto const bits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_slli_epi16(reversed, 7)));
+		result = (result << 16) | bits;
+	}
+#endif
+	for (; n >= 8; it += 8, n -= 8)
+	{
+		std::uint64_t chars;
+		std::memcpy(&chars, it, 8);
+		result = (result << 8) | (((chars & 0x0101'0101'0101'0101) * 0x8040'2010'0804'0201) >> 56);
+	}
+	if (n != 0)
+	{
+		auto const chars = load_up_to_8(it, n, '0');
+		result = (result << n) | (((chars & 0x0101'0101'0101'0101) * 0x8040'2010'0804'0201) >> 56);
+	}
+	return result;
+}
+
+} // namespace internal
+
 template<typename Int>
 Int parse_int(std::string_view str) noexcept
 {
@@ -73,6 +276,16 @@ Int parse_int(std::string_view str) noexcept
 	{
 		str = str.substr(1);
 	}
+	// short numbers are parsed faster by the simple loop below
+	if constexpr (internal::is_fast_parse_int_v<Int>)
+	{
+		if (str.size() >= 16)
+		{
+			auto const digit_count = internal::count_digits(str.data(), str.data() + str.size());
+			auto const result = internal::parse_decimal_digits(str.data(), digit_count);
+			return static_cast<Int>(sign ? std::uint64_t(0) - result : result);
+		}
+	}
 	Int result(0);
 	for (auto const c : str)
 	{
@@ -95,6 +308,19 @@ Int parse_int_base(std::string_view str) noexcept
 	{
 		str = str.substr(1);
 	}
+	if constexpr (Base == 10)
+	{
+		return sign ? -parse_int<Int>(str) : parse_int<Int>(str);
+	}
+	else if constexpr (Base == 2 && internal::is_fast_parse_int_v<Int>)
+	{
+		if (str.size() >= 16)
+		{
+			auto const digit_count = internal::count_digits(str.data(), str.data() + str.size());
+			auto const result = internal::parse_binary_digits(str.data(), digit_count);
+			return static_cast<Int>(sign ? std::uint64_t(0) - result : result);
+		}
+	}
 	Int result(0);
 	for (auto const c : str)
 	{
@@ -108,34 +334,843 @@ Int parse_int_base(std::string_view str) noexcept
 	return sign ? -result : result;
 }
 
+// parses every number in buffer, with any characters other than digits and '-' acting as separators,
+// e.g. "1,2,-3" or "1\n2\n-3"
+template<typename Int>
+vector<Int> parse_ints(std::string_view buffer)
+{
+	static_assert(internal::is_fast_parse_int_v<Int>);
+	vector<Int> result;
+	auto it = buffer.data();
+	auto const end = it + buffer.size();
+	while (true)
+	{
+		while (it != end && *it != '-' && (*it < '0' || *it > '9'))
+		{
+			++it;
+		}
+		if (it == end)
+		{
+			break;
+		}
+		auto const sign = *it == '-';
+		it += static_cast<std::size_t>(sign);
+		auto const digit_count = internal::count_digits(it, end);
+		auto const value = internal::parse_decimal_digits(it, digit_count);
+		it += digit_count;
+		result.push_back(static_cast<Int>(sign ? std::uint64_t(0) - value : value));
+	}
+	return result;
+}
+
+// read-only view of a whole file, mapped into memory instead of being read through a stream
+// if the file can't be opened the contents are empty, the same as reading from a failed std::ifstream
+struct mapped_file
+{
+private:
+	char const *_data = nullptr;
+	std::size_t _size = 0;
+#ifdef _WIN32
+	HANDLE _file = INVALID_HANDLE_VALUE;
+	HANDLE _mapping = nullptr;
+#endif
+
+public:
+	explicit mapped_file(fs::path const &file)
+	{
+#ifdef _WIN32
+		this->_file = CreateFileW(
+			file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+		);
+		if (this->_file == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(this->_file, &size) || size.QuadPart == 0)
+		{
+			return;
+		}
+		this->_mapping = CreateFileMappingW(this->_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (this->_mapping == nullptr)
+		{
+			return;
+		}
+		auto const data = MapViewOfFile(this->_mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data != nullptr)
+		{
+			this->_data = static_cast<char const *>(data);
+			this->_size = static_cast<std::size_t>(size.QuadPart);
+		}
+#else
+		auto const fd = ::open(file.c_str(), O_RDONLY);
+		if (fd == -1)
+		{
+			return;
+		}
+		struct stat file_stat;
+		if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+		{
+			auto const size = static_cast<std::size_t>(file_stat.st_size);
+			auto const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED)
+			{
+				::madvise(data, size, MADV_SEQUENTIAL);
+				this->_data = static_cast<char const *>(data);
+				this->_size = size;
+			}
+		}
+		// the mapping stays valid after the descriptor is closed
+		::close(fd);
+#endif
+	}
+
+	mapped_file(mapped_file const &) = delete;
+	mapped_file &operator = (mapped_file const &) = delete;
+
+	~mapped_file(void)
+	{
+#ifdef _WIN32
+		if (this->_data != nullptr)
+		{
+			UnmapViewOfFile(this->_data);
+		}
+		if (this->_mapping != nullptr)
+		{
+			CloseHandle(this->_mapping);
+		}
+		if (this->_file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(this->_file);
+		}
+#else
+		if (this->_data != nullptr)
+		{
+			::munmap(const_cast<char *>(this->_data), this->_size);
+		}
+#endif
+	}
+
+	std::string_view contents(void) const noexcept
+	{ return std::string_view(this->_data, this->_size); }
+};
+
+// calls func with every line of buffer, with the same line splitting rules as std::getline:
+// the last line is only reported if it's not empty, and a trailing '\r' is removed, like
+// reading the file in text mode would on windows
+template<typename Func>
+void for_each_line(std::string_view buffer, Func &&func)
+{
+	auto it = buffer.data();
+	auto const end = it + buffer.size();
+	while (it != end)
+	{
+		auto const newline = static_cast<char const *>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+		auto const line_end = newline == nullptr ? end : newline;
+		auto line = string_view(it, static_cast<std::size_t>(line_end - it));
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.remove_suffix(1);
+		}
+		func(line);
+		it = newline == nullptr ? end : newline + 1;
+	}
+}
+
+namespace internal
+{
+
+// a parse function that returns the line itself would leave views into the unmapped file,
+// so those are stored as owning strings instead
+template<typename T>
+using read_file_value_t = std::conditional_t<
+	std::is_same_v<std::decay_t<T>, string_view> || std::is_same_v<std::decay_t<T>, std::string_view>,
+	string,
+	std::decay_t<T>
+>;
+
+} // namespace internal
+
 template<typename ParseFunc>
 auto read_file(fs::path const &file, ParseFunc parse_func)
 {
-	auto data_file = std::ifstream(file);
+	auto const data_file = mapped_file(file);
+
+	vector<internal::read_file_value_t<decltype(parse_func(std::declval<string_view &>()))>> result;
+
+	for_each_line(data_file.contents(), [&](string_view &line) {
+		result.emplace_back(parse_func(line));
+	});
+
+	return result;
+}
+
+// same as read_file, but the file is split into chunks at line boundaries, which are parsed on
+// separate threads; the results are concatenated in the order of the lines in the file
+// parse_func is called concurrently, so it must not modify any shared state
+template<typename ParseFunc>
+auto read_file_parallel(fs::path const &file, ParseFunc parse_func)
+{
+	auto const data_file = mapped_file(file);
+	auto const contents = data_file.contents();
+
+	using value_t = internal::read_file_value_t<decltype(parse_func(std::declval<string_view &>()))>;
+
+	// every thread parses at least a megabyte of the file
+	constexpr std::size_t min_chunk_size = 1 << 20;
+	std::size_t const max_thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+	auto const chunk_count = std::clamp(contents.size() / min_chunk_size, std::size_t(1), max_thread_count);
+
+	vector<std::string_view> chunks;
+	chunks.reserve(chunk_count);
+	auto chunk_begin = std::size_t(0);
+	for (auto const i : utils::iota(std::size_t(1), chunk_count + 1))
+	{
+		auto chunk_end = contents.size();
+		if (i != chunk_count)
+		{
+			chunk_end = std::max(chunk_begin, contents.size() / chunk_count * i);
+			chunk_end = contents.find('\n', chunk_end);
+			chunk_end = chunk_end == std::string_view::npos ? contents.size() : chunk_end + 1;
+		}
+		chunks.push_back(contents.substr(chunk_begin, chunk_end - chunk_begin));
+		chunk_begin = chunk_end;
+	}
+
+	vector<vector<value_t>> chunk_results(chunks.size());
+	auto const parse_chunk = [&](std::size_t const i) {
+		for_each_line(chunks[i], [&, &chunk_result = chunk_results[i]](string_view &line) {
+			chunk_result.emplace_back(parse_func(line));
+		});
+	};
+
+	{
+		vector<std::jthread> threads;
+		threads.reserve(chunks.size() - 1);
+		for (auto const i : utils::iota(std::size_t(1), chunks.size()))
+		{
+			threads.emplace_back(parse_chunk, i);
+		}
+		parse_chunk(0);
+	}
+
+	if (chunk_results.size() == 1)
+	{
+		return std::move(chunk_results[0]);
+	}
+
+	vector<value_t> result;
+	result.reserve(chunk_results.transform([](auto const &chunk_result) { return chunk_result.size(); }).sum());
+	for (auto &chunk_result : chunk_results)
+	{
+		std::move(chunk_result.begin(), chunk_result.end(), std::back_inserter(result));
+	}
+	return result;
+}
+
+// reads a file or a pipe line by line through a fixed size buffer, so inputs of any size can be
+// processed with constant memory; the buffer only grows if a line doesn't fit into it
+// if the file can't be opened it has no lines, the same as reading from a failed std::ifstream
+struct line_reader
+{
+	static constexpr std::size_t default_buffer_size = 1 << 16;
+
+private:
+	std::unique_ptr<char[]> _buffer;
+	std::size_t _capacity = 0;
+	// the unread data is [_begin, _end) in _buffer
+	std::size_t _begin = 0;
+	std::size_t _end = 0;
+	bool _is_eof = false;
+#ifdef _WIN32
+	HANDLE _file = INVALID_HANDLE_VALUE;
+#else
+	int _fd = -1;
+#endif
+	bool _owns_file = false;
+
+	std::size_t read_some(char *data, std::size_t size)
+	{
+#ifdef _WIN32
+		DWORD read_count = 0;
+		auto const max_read_size = static_cast<DWORD>(std::min<std::size_t>(size, 1u << 30));
+		if (this->_file == INVALID_HANDLE_VALUE || !ReadFile(this->_file, data, max_read_size, &read_count, nullptr))
+		{
+			return 0;
+		}
+		return read_count;
+#else
+		if (this->_fd == -1)
+		{
+			return 0;
+		}
+		while (true)
+		{
+			auto const read_count = ::read(this->_fd, data, size);
+			if (read_count >= 0)
+			{
+				return static_cast<std::size_t>(read_count);
+			}
+			else if (errno != EINTR)
+			{
+				return 0;
+			}
+		}
+#endif
+	}
+
+	// moves the unread data to the start of the buffer and fills the rest
+	void refill(void)
+	{
+		auto const unread_size = this->_end - this->_begin;
+		if (unread_size == this->_capacity)
+		{
+			// the current line doesn't fit into the buffer
+			auto new_buffer = std::make_unique<char[]>(2 * this->_capacity);
+			std::memcpy(new_buffer.get(), this->_buffer.get() + this->_begin, unread_size);
+			this->_buffer = std::move(new_buffer);
+			this->_capacity *= 2;
+		}
+		else if (this->_begin != 0)
+		{
+			std::memmove(this->_buffer.get(), this->_buffer.get() + this->_begin, unread_size);
+		}
+		this->_begin = 0;
+		this->_end = unread_size;
+
+		auto const read_count = this->read_some(this->_buffer.get() + this->_end, this->_capacity - this->_end);
+		this->_end += read_count;
+		this->_is_eof = read_count == 0;
+	}
+
+	explicit line_reader(std::size_t buffer_size)
+		: _buffer(std::make_unique<char[]>(std::max(buffer_size, std::size_t(1)))),
+		  _capacity(std::max(buffer_size, std::size_t(1)))
+	{}
+
+public:
+	explicit line_reader(fs::path const &file, std::size_t buffer_size = default_buffer_size)
+		: line_reader(buffer_size)
+	{
+		this->_owns_file = true;
+#ifdef _WIN32
+		this->_file = CreateFileW(
+			file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+		);
+#else
+		this->_fd = ::open(file.c_str(), O_RDONLY);
+		if (this->_fd != -1)
+		{
+			::posix_fadvise(this->_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+		}
+#endif
+	}
+
+	// reads the standard input, which isn't closed by the destructor
+	static line_reader from_stdin(std::size_t buffer_size = default_buffer_size)
+	{
+		auto result = line_reader(buffer_size);
+#ifdef _WIN32
+		result._file = GetStdHandle(STD_INPUT_HANDLE);
+#else
+		result._fd = STDIN_FILENO;
+#endif
+		return result;
+	}
+
+	line_reader(line_reader &&other) noexcept
+		: _buffer(std::move(other._buffer)), _capacity(other._capacity),
+		  _begin(other._begin), _end(other._end), _is_eof(other._is_eof),
+#ifdef _WIN32
+		  _file(std::exchange(other._file, INVALID_HANDLE_VALUE)),
+#else
+		  _fd(std::exchange(other._fd, -1)),
+#endif
+		  _owns_file(std::exchange(other._owns_file, false))
+	{}
+
+	line_reader(line_reader const &) = delete;
+	line_reader &operator = (line_reader const &) = delete;
+	line_reader &operator = (line_reader &&) = delete;
+
+	~line_reader(void)
+	{
+		if (!this->_owns_file)
+		{
+			return;
+		}
+#ifdef _WIN32
+		if (this->_file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(this->_file);
+		}
+#else
+		if (this->_fd != -1)
+		{
+			::close(this->_fd);
+		}
+#endif
+	}
+
+	// reads the next line into line, with the same line splitting rules as for_each_line
+	// line points into the buffer, so it's only valid until the next call
+	// returns false if there are no more lines
+	bool next_line(string_view &line)
+	{
+		while (true)
+		{
+			auto const begin = this->_buffer.get() + this->_begin;
+			auto const unread_size = this->_end - this->_begin;
+			auto const newline = static_cast<char const *>(std::memchr(begin, '\n', unread_size));
+			if (newline != nullptr || (this->_is_eof && unread_size != 0))
+			{
+				auto const line_size = newline == nullptr ? unread_size : static_cast<std::size_t>(newline - begin);
+				line = string_view(begin, line_size);
+				if (!line.empty() && line.back() == '\r')
+				{
+					line.remove_suffix(1);
+				}
+				this->_begin += newline == nullptr ? line_size : line_size + 1;
+				return true;
+			}
+			else if (this->_is_eof)
+			{
+				return false;
+			}
+			this->refill();
+		}
+	}
+};
+
+// single pass range of the parsed lines of a line_reader, which must outlive the range
+// the lines are read while the range is iterated, so only the current line is kept in memory
+// unlike read_file, a parse function that returns the line itself gives views into the read buffer,
+// which are only valid until the range is advanced
+template<typename ParseFunc>
+struct line_stream_range : utils::range_base<line_stream_range<ParseFunc>>
+{
+private:
+	using self_t  = line_stream_range<ParseFunc>;
+	using value_t = std::decay_t<decltype(std::declval<ParseFunc &>()(std::declval<string_view &>()))>;
+private:
+	line_reader *_reader;
+	ParseFunc _parse_func;
+	// copies of the range share the reader, so only one of them can be iterated
+	std::optional<value_t> _value;
+
+	void read_next(void)
+	{
+		string_view line;
+		if (this->_reader->next_line(line))
+		{
+			this->_value.emplace(this->_parse_func(line));
+		}
+		else
+		{
+			this->_value.reset();
+		}
+	}
 
-	vector<decltype(parse_func(std::declval<string&>()))> result;
+public:
+	line_stream_range(line_reader &reader, ParseFunc parse_func)
+		: _reader(&reader), _parse_func(std::move(parse_func)), _value()
+	{
+		this->read_next();
+	}
+
+	bool at_end(void) const noexcept
+	{ return !this->_value.has_value(); }
 
-	string line;
-	while (std::getline(data_file, line))
+	self_t &operator ++ (void)
 	{
-		result.push_back(parse_func(line));
+		this->read_next();
+		return *this;
 	}
 
+	value_t const &operator * (void) const noexcept
+	{ return *this->_value; }
+
+	value_t const *operator -> (void) const noexcept
+	{ return &*this->_value; }
+
+	friend bool operator == (self_t const &lhs, [[maybe_unused]] utils::universal_end_sentinel<self_t> rhs) noexcept
+	{ return lhs.at_end(); }
+
+	friend bool operator == ([[maybe_unused]] utils::universal_end_sentinel<self_t> lhs, self_t const &rhs) noexcept
+	{ return rhs.at_end(); }
+
+	friend bool operator != (self_t const &lhs, [[maybe_unused]] utils::universal_end_sentinel<self_t> rhs) noexcept
+	{ return !lhs.at_end(); }
+
+	friend bool operator != ([[maybe_unused]] utils::universal_end_sentinel<self_t> lhs, self_t const &rhs) noexcept
+	{ return !rhs.at_end(); }
+
+
+	self_t begin(void) const noexcept
+	{ return *this; }
+
+	utils::universal_end_sentinel<self_t> end(void) const noexcept
+	{ return utils::universal_end_sentinel<self_t>{}; }
+
+	decltype(auto) front(void) const noexcept
+	{ return **this; }
+
+	utils::size_hint_t size_hint(void) const noexcept
+	{ return { utils::size_hint_t::unknown, 0 }; }
+};
+
+// streaming counterpart of read_file for inputs that only need one forward pass
+template<typename ParseFunc>
+auto stream_lines(line_reader &reader, ParseFunc parse_func)
+{
+	return line_stream_range<ParseFunc>(reader, std::move(parse_func));
+}
+
+namespace internal
+{
+
+// bitmask of the positions of c in the (up to) 64 characters starting at it
+inline std::uint64_t find_char_mask(char const *it, char const *end, char c) noexcept
+{
+	std::uint64_t result = 0;
+	if (end - it >= 64)
+	{
+#if AOC_HAS_AVX2
+		auto const c_vec = _mm256_set1_epi8(c);
+		auto const low  = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(it)), c_vec);
+		auto const high = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(it + 32)), c_vec);
+		return std::uint64_t(static_cast<std::uint32_t>(_mm256_movemask_epi8(low)))
+			| (std::uint64_t(static_cast<std::uint32_t>(_mm256_movemask_epi8(high))) << 32);
+#elif AOC_HAS_SSE4_1
+		auto const c_vec = _mm_set1_epi8(c);
+		for (auto const i : utils::iota(0, 4))
+		{
+			auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(it + 16 * i));
+			auto const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, c_vec)));
+			result |= std::uint64_t(mask) << (16 * i);
+		}
+		return result;
+#else
+		end = it + 64;
+#endif
+	}
+	for (auto const i : utils::iota(0, end - it))
+	{
+		result |= std::uint64_t(it[i] == c) << i;
+	}
 	return result;
 }
 
-inline vector<std::string_view> split_by(std::string_view str, std::string_view split_str)
+} // namespace internal
+
+// lazy range of the parts of a string separated by a delimiter
+// delimiter candidates are found by matching its first character 64 bytes at a time
+struct split_range : utils::range_base<split_range>
 {
-	vector<std::string_view> result;
-	auto it = str.find(split_str);
-	while (it != std::string_view::npos)
+private:
+	using self_t = split_range;
+private:
+	char const *_end;
+	std::string_view _delimiter;
+	char const *_block;
+	std::uint64_t _block_mask;
+	std::string_view _current;
+	bool _is_last;
+	bool _at_end;
+
+	char const *find_delimiter(char const *it) noexcept
 	{
-		result.push_back(str.substr(0, it));
-		str = str.substr(it + split_str.size());
-		it = str.find(split_str);
+		while (true)
+		{
+			while (this->_block_mask != 0)
+			{
+				auto const pos = this->_block + std::countr_zero(this->_block_mask);
+				this->_block_mask &= this->_block_mask - 1;
+				if (
+					pos >= it
+					&& static_cast<std::size_t>(this->_end - pos) >= this->_delimiter.size()
+					&& std::memcmp(pos + 1, this->_delimiter.data() + 1, this->_delimiter.size() - 1) == 0
+				)
+				{
+					return pos;
+				}
+			}
+			if (this->_end - this->_block <= 64)
+			{
+				return this->_end;
+			}
+			this->_block += 64;
+			this->_block_mask = internal::find_char_mask(this->_block, this->_end, this->_delimiter[0]);
+		}
 	}
-	result.push_back(str);
+
+	void find_current(char const *begin) noexcept
+	{
+		auto const current_end = this->find_delimiter(begin);
+		this->_current = std::string_view(begin, static_cast<std::size_t>(current_end - begin));
+		this->_is_last = current_end == this->_end;
+	}
+
+public:
+	split_range(std::string_view str, std::string_view delimiter)
+		: _end(str.data() + str.size()),
+		  _delimiter(delimiter),
+		  _block(str.data()),
+		  _block_mask(0),
+		  _current(),
+		  _is_last(false),
+		  _at_end(false)
+	{
+		assert(!delimiter.empty());
+		if (!str.empty())
+		{
+			this->_block_mask = internal::find_char_mask(this->_block, this->_end, this->_delimiter[0]);
+		}
+		this->find_current(str.data());
+	}
+
+	bool at_end(void) const noexcept
+	{ return this->_at_end; }
+
+	self_t &operator ++ (void)
+	{
+		if (this->_is_last)
+		{
+			this->_at_end = true;
+		}
+		else
+		{
+			this->find_current(this->_current.data() + this->_current.size() + this->_delimiter.size());
+		}
+		return *this;
+	}
+
+	std::string_view const &operator * (void) const noexcept
+	{ return this->_current; }
+
+	std::string_view const *operator -> (void) const noexcept
+	{ return &this->_current; }
+
+	friend bool operator == (self_t const &lhs, [[maybe_unused]] utils::universal_end_sentinel<self_t> rhs) noexcept
+	{ return lhs.at_end(); }
+
+	friend bool operator == ([[maybe_unused]] utils::universal_end_sentinel<self_t> lhs, self_t const &rhs) noexcept
+	{ return rhs.at_end(); }
+
+	friend bool operator != (self_t const &lhs, [[maybe_unused]] utils::universal_end_sentinel<self_t> rhs) noexcept
+	{ return !lhs.at_end(); }
+
+	friend bool operator != ([[maybe_unused]] utils::universal_end_sentinel<self_t> lhs, self_t const &rhs) noexcept
+	{ return !rhs.at_end(); }
+
+
+	self_t begin(void) const noexcept
+	{ return *this; }
+
+	utils::universal_end_sentinel<self_t> end(void) const noexcept
+	{ return utils::universal_end_sentinel<self_t>{}; }
+
+	decltype(auto) front(void) const noexcept
+	{ return **this; }
+};
+
+// doesn't allocate; use .collect<vector>() if the parts need to be indexed
+inline split_range split_by(std::string_view str, std::string_view split_str)
+{
+	return split_range(str, split_str);
+}
+
+// two dimensional grid in one contiguous allocation, indexed as grid(row, column)
+// it can have a border of padding cells on every side, which are accessed with indices in
+// [-padding, 0) and [size, size + padding), so neighbours can be read without checking the edges
+template<typename T>
+struct grid
+{
+	static_assert(!std::is_same_v<T, bool>, "vector<bool> isn't contiguous, use a byte sized type instead");
+
+private:
+	vector<T> _cells;
+	std::size_t _height = 0;
+	std::size_t _width = 0;
+	std::size_t _padding = 0;
+	// up, down, left, right, then the diagonals
+	std::array<std::ptrdiff_t, 8> _neighbour_offsets{};
+
+	template<typename Cell>
+	static auto neighbours_of(Cell *cell, std::ptrdiff_t const *offsets, std::size_t count)
+	{
+		return utils::basic_range(offsets, offsets + count)
+			.transform([cell](auto const offset) -> Cell & { return cell[offset]; });
+	}
+
+public:
+	grid(void) = default;
+
+	grid(std::size_t height, std::size_t width, T const &value = T(), std::size_t padding = 0)
+		: _cells((height + 2 * padding) * (width + 2 * padding), value),
+		  _height(height), _width(width), _padding(padding)
+	{
+		auto const stride = static_cast<std::ptrdiff_t>(this->stride());
+		this->_neighbour_offsets = { -stride, stride, -1, 1, -stride - 1, -stride + 1, stride - 1, stride + 1 };
+	}
+
+	std::size_t height(void) const noexcept
+	{ return this->_height; }
+
+	std::size_t width(void) const noexcept
+	{ return this->_width; }
+
+	std::size_t padding(void) const noexcept
+	{ return this->_padding; }
+
+	// distance between two vertically adjacent cells in data()
+	std::size_t stride(void) const noexcept
+	{ return this->_width + 2 * this->_padding; }
+
+	// position of a cell in data()
+	std::size_t index(std::ptrdiff_t i, std::ptrdiff_t j) const noexcept
+	{
+		auto const padding = static_cast<std::ptrdiff_t>(this->_padding);
+		assert(i >= -padding && i < static_cast<std::ptrdiff_t>(this->_height) + padding);
+		assert(j >= -padding && j < static_cast<std::ptrdiff_t>(this->_width) + padding);
+		return static_cast<std::size_t>((i + padding) * static_cast<std::ptrdiff_t>(this->stride()) + (j + padding));
+	}
+
+	T *data(void) noexcept
+	{ return this->_cells.data(); }
+
+	T const *data(void) const noexcept
+	{ return this->_cells.data(); }
+
+	T &operator () (std::ptrdiff_t i, std::ptrdiff_t j) noexcept
+	{ return this->_cells[this->index(i, j)]; }
+
+	T const &operator () (std::ptrdiff_t i, std::ptrdiff_t j) const noexcept
+	{ return this->_cells[this->index(i, j)]; }
+
+	// the cells of row i, without the padding
+	span<T> row(std::size_t i) noexcept
+	{ return span<T>(this->data() + this->index(i, 0), this->_width); }
+
+	span<T const> row(std::size_t i) const noexcept
+	{ return span<T const>(this->data() + this->index(i, 0), this->_width); }
+
+	auto rows(void) noexcept
+	{ return utils::iota(std::size_t(0), this->_height).transform([this](auto const i) { return this->row(i); }); }
+
+	auto rows(void) const noexcept
+	{ return utils::iota(std::size_t(0), this->_height).transform([this](auto const i) { return this->row(i); }); }
+
+	// the cells of column j, without the padding
+	auto column(std::size_t j) noexcept
+	{
+		return utils::iota(std::size_t(0), this->_height)
+			.transform([first = this->data() + this->index(0, j), stride = this->stride()](auto const i) -> T & {
+				return first[i * stride];
+			});
+	}
+
+	auto column(std::size_t j) const noexcept
+	{
+		return utils::iota(std::size_t(0), this->_height)
+			.transform([first = this->data() + this->index(0, j), stride = this->stride()](auto const i) -> T const & {
+				return first[i * stride];
+			});
+	}
+
+	// the 4 orthogonal neighbours of a cell, which are in the padding on the edges
+	auto neighbours_4(std::ptrdiff_t i, std::ptrdiff_t j) noexcept
+	{ return neighbours_of(&(*this)(i, j), this->_neighbour_offsets.data(), 4); }
+
+	auto neighbours_4(std::ptrdiff_t i, std::ptrdiff_t j) const noexcept
+	{ return neighbours_of(&(*this)(i, j), this->_neighbour_offsets.data(), 4); }
+
+	// the 8 neighbours of a cell, including the diagonal ones
+	auto neighbours_8(std::ptrdiff_t i, std::ptrdiff_t j) noexcept
+	{ return neighbours_of(&(*this)(i, j), this->_neighbour_offsets.data(), 8); }
+
+	auto neighbours_8(std::ptrdiff_t i, std::ptrdiff_t j) const noexcept
+	{ return neighbours_of(&(*this)(i, j), this->_neighbour_offsets.data(), 8); }
+
+	void fill_padding(T const &value)
+	{
+		auto const padding = static_cast<std::ptrdiff_t>(this->_padding);
+		auto const height = static_cast<std::ptrdiff_t>(this->_height);
+		auto const width = static_cast<std::ptrdiff_t>(this->_width);
+		for (auto const i : utils::iota(-padding, height + padding))
+		{
+			auto const is_padding_row = i < 0 || i >= height;
+			for (auto const j : utils::iota(-padding, width + padding))
+			{
+				if (is_padding_row || j < 0 || j >= width)
+				{
+					(*this)(i, j) = value;
+				}
+			}
+		}
+	}
+};
+
+// parses a grid from lines of equal length, parse_func is called with every character
+// empty lines are skipped
+template<typename ParseFunc>
+auto parse_grid(std::string_view contents, ParseFunc parse_func, std::size_t padding, decltype(parse_func(char())) padding_value)
+{
+	using value_t = decltype(parse_func(char()));
+
+	std::size_t height = 0;
+	std::size_t width = 0;
+	for_each_line(contents, [&](string_view &line) {
+		if (line.empty())
+		{
+			return;
+		}
+		assert(height == 0 || line.size() == width);
+		width = line.size();
+		++height;
+	});
+
+	auto result = grid<value_t>(height, width, padding_value, padding);
+	std::size_t i = 0;
+	for_each_line(contents, [&](string_view &line) {
+		if (line.empty())
+		{
+			return;
+		}
+		auto const row = result.row(i);
+		for (auto const j : utils::iota(std::size_t(0), width))
+		{
+			row[j] = parse_func(line[j]);
+		}
+		++i;
+	});
 	return result;
 }
 
+template<typename ParseFunc>
+auto parse_grid(std::string_view contents, ParseFunc parse_func)
+{
+	return parse_grid(contents, std::move(parse_func), 0, decltype(parse_func(char()))());
+}
+
+template<typename ParseFunc>
+auto read_grid(fs::path const &file, ParseFunc parse_func, std::size_t padding, decltype(parse_func(char())) padding_value)
+{
+	auto const data_file = mapped_file(file);
+	return parse_grid(data_file.contents(), std::move(parse_func), padding, std::move(padding_value));
+}
+
+template<typename ParseFunc>
+auto read_grid(fs::path const &file, ParseFunc parse_func)
+{
+	auto const data_file = mapped_file(file);
+	return parse_grid(data_file.contents(), std::move(parse_func));
+}
+
+#ifdef AOC_BENCH
+#include "bench/bench.h"
+#endif // AOC_BENCH
+
 #endif // AOC_COMMON_H
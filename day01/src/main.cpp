@@ -1,7 +1,13 @@
 #include <iostream>
 #include "common.h"
+#include "sonar.h"
 
-static int solution_part_1(span<int const> depth_data)
+namespace
+{
+
+// the solutions work on any range of depths, so they can also be used on a stream_lines range
+template<typename Depths>
+static int solution_part_1_impl(Depths const &depth_data)
 {
 	return depth_data
 		.adjacent()
@@ -9,18 +15,85 @@ static int solution_part_1(span<int const> depth_data)
 		.sum();
 }
 
-static int solution_part_2(span<int const> depth_data)
+template<typename Depths>
+static int solution_part_2_impl(Depths const &depth_data)
 {
 	return depth_data
-		.running_sum<3>()
+		.template running_sum<3>()
 		.adjacent()
 		.transform([](auto const pair) { return pair.second > pair.first ? 1 : 0; })
 		.sum();
 }
 
-int main(void)
+static int solution_part_1(span<int const> depth_data)
 {
-	auto const depth_data = read_file("input.txt", [](auto const &line) { return parse_int<int>(line); });
+	return static_cast<int>(sonar::count_increases(depth_data, 1));
+}
+
+static int solution_part_2(span<int const> depth_data)
+{
+	return static_cast<int>(sonar::count_increases(depth_data, 3));
+}
+
+static int parse_depth(string_view const &line)
+{
+	return parse_int<int>(line);
+}
+
+static auto read_input(fs::path const &filename)
+{
+	return read_file_parallel(filename, &parse_depth);
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(1, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+// with "--stream <part> [file]" the given part is solved while reading the file, or the standard
+// input if no file is given, so the input can be piped in and doesn't need to fit into memory
+// with "--windows <max size> [file]" the increases are counted for every window size up to max size
+int main(int argc, char **argv)
+{
+	if (argc >= 3 && argc <= 4 && std::string_view(argv[1]) == "--windows")
+	{
+		auto const max_window_size = parse_int<std::size_t>(std::string_view(argv[2]));
+		auto const depth_data = read_input(argc == 4 ? argv[3] : "input.txt");
+		auto const window_sizes = utils::iota(std::size_t(1), max_window_size + 1).collect<vector>();
+		auto const counts = sonar::count_increases(depth_data, window_sizes);
+		for (auto const &[index, count] : counts.enumerate())
+		{
+			fmt::print("{}: {}\n", window_sizes[index], count);
+		}
+		return 0;
+	}
+
+	if (argc >= 3 && argc <= 4 && std::string_view(argv[1]) == "--stream")
+	{
+		auto reader = argc == 4 ? line_reader(argv[3]) : line_reader::from_stdin();
+		auto const depths = stream_lines(reader, &parse_depth);
+		auto const part = std::string_view(argv[2]);
+		if (part == "1")
+		{
+			fmt::print("part 1: {}\n", solution_part_1_impl(depths));
+			return 0;
+		}
+		else if (part == "2")
+		{
+			fmt::print("part 2: {}\n", solution_part_2_impl(depths));
+			return 0;
+		}
+	}
+	if (argc != 1)
+	{
+		fmt::print(stderr, "usage: {} [--stream <part> [file] | --windows <max size> [file]]\n", argv[0]);
+		return 1;
+	}
+
+	auto const depth_data = read_input("input.txt");
 	auto const part_1_result = solution_part_1(depth_data);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(depth_data);
@@ -28,3 +101,5 @@ int main(void)
 
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -0,0 +1,93 @@
+#ifndef AOC_DAY01_SONAR_H
+#define AOC_DAY01_SONAR_H
+
+#include "common.h"
+
+// counts of increasing sliding window sums of sonar depths, for any number of window sizes
+// the sums of windows of size k starting at i and i + 1 share k - 1 depths, so the second one
+// is larger exactly if depths[i + k] > depths[i], which means no sums are needed at all
+
+namespace sonar
+{
+
+namespace internal
+{
+
+// number of indices i < size for which rhs[i] > lhs[i]
+inline std::size_t count_greater(int const *lhs, int const *rhs, std::size_t size) noexcept
+{
+	std::size_t result = 0;
+	std::size_t i = 0;
+#if AOC_HAS_AVX2
+	// the comparisons give -1 for true, which are subtracted in 8 lanes
+	auto counts = _mm256_setzero_si256();
+	for (; i + 8 <= size; i += 8)
+	{
+		auto const lhs_vec = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lhs + i));
+		auto const rhs_vec = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rhs + i));
+		counts = _mm256_sub_epi32(counts, _mm256_cmpgt_epi32(rhs_vec, lhs_vec));
+	}
+	alignas(32) std::array<std::uint32_t, 8> lane_counts;
+	_mm256_store_si256(reinterpret_cast<__m256i *>(lane_counts.data()), counts);
+	for (auto const lane_count : lane_counts)
+	{
+		result += lane_count;
+	}
+#endif
+	// without AVX2 the compiler vectorizes this loop with SSE2
+	for (; i < size; ++i)
+	{
+		result += rhs[i] > lhs[i] ? 1 : 0;
+	}
+	return result;
+}
+
+// the depths are processed in blocks this long, so that every window size reads them from cache
+inline constexpr std::size_t block_size = 4096;
+
+} // namespace internal
+
+// number of windows of window_size depths whose sum is larger than the sum of the previous window
+inline std::size_t count_increases(span<int const> depths, std::size_t window_size) noexcept
+{
+	assert(window_size != 0);
+	if (depths.size() <= window_size)
+	{
+		return 0;
+	}
+	return internal::count_greater(depths.data(), depths.data() + window_size, depths.size() - window_size);
+}
+
+// count_increases for every window size, in one pass over the depths
+// result[i] is the count for window_sizes[i]
+inline vector<std::size_t> count_increases(span<int const> depths, span<std::size_t const> window_sizes)
+{
+	auto result = vector<std::size_t>(window_sizes.size(), 0);
+	for (std::size_t block_begin = 0; block_begin < depths.size(); block_begin += internal::block_size)
+	{
+		for (auto const &[index, window_size] : window_sizes.enumerate())
+		{
+			assert(window_size != 0);
+			if (depths.size() <= window_size)
+			{
+				continue;
+			}
+			auto const compare_count = depths.size() - window_size;
+			if (block_begin >= compare_count)
+			{
+				continue;
+			}
+			auto const block_end = std::min(block_begin + internal::block_size, compare_count);
+			result[index] += internal::count_greater(
+				depths.data() + block_begin,
+				depths.data() + block_begin + window_size,
+				block_end - block_begin
+			);
+		}
+	}
+	return result;
+}
+
+} // namespace sonar
+
+#endif // AOC_DAY01_SONAR_H
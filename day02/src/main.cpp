@@ -1,86 +1,155 @@
 #include "common.h"
 
-enum class direction
+namespace
+{
+
+enum class direction : std::uint8_t
 {
 	forward,
 	up,
 	down,
 };
 
-static direction direction_from_string(std::string_view dir)
+struct command_t
+{
+	direction dir;
+	std::int32_t amount;
+};
+
+static_assert(sizeof (command_t) == 8);
+
+// position, aim and depth after a sequence of commands starting from zero, with part 1's depth
+// being the same as the aim
+// a sequence of commands is an affine map of (position, aim, depth), so two consecutive sequences
+// can be combined: the second one moves forward with the aim of the first one added to its own,
+// which makes combine associative, and the commands can be reduced in parallel
+// the values wrap around, so the results are exact whenever they fit into 64 bits
+struct course_t
+{
+	std::uint64_t position;
+	std::uint64_t aim;
+	std::uint64_t depth;
+};
+
+static course_t combine(course_t const &lhs, course_t const &rhs)
+{
+	return {
+		lhs.position + rhs.position,
+		lhs.aim + rhs.aim,
+		lhs.depth + rhs.depth + lhs.aim * rhs.position,
+	};
+}
+
+// branchless, because the directions of consecutive commands are hard to predict
+static course_t to_course(command_t const &command)
+{
+	auto const amount = static_cast<std::uint64_t>(command.amount);
+	auto const is_forward = static_cast<std::uint64_t>(command.dir == direction::forward);
+	auto const aim_sign = static_cast<std::uint64_t>(command.dir == direction::down) - static_cast<std::uint64_t>(command.dir == direction::up);
+	return { amount * is_forward, amount * aim_sign, 0 };
+}
+
+// works on any range of commands, so it can also be used on a stream_lines range
+template<typename Commands>
+static course_t follow_course(Commands const &commands)
+{
+	return commands
+		.transform([](auto const &command) { return to_course(command); })
+		.reduce(course_t{}, [](auto const &lhs, auto const &rhs) { return combine(lhs, rhs); });
+}
+
+static course_t follow_course_parallel(span<command_t const> commands)
+{
+	constexpr std::size_t min_parallel_size = 1 << 16;
+	return commands
+		.transform([](auto const &command) { return to_course(command); })
+		.par(min_parallel_size)
+		.reduce(course_t{}, [](auto const &lhs, auto const &rhs) { return combine(lhs, rhs); });
+}
+
+static std::int64_t get_part_1_result(course_t const &course)
+{
+	return static_cast<std::int64_t>(course.position * course.aim);
+}
+
+static std::int64_t get_part_2_result(course_t const &course)
 {
-	if (dir == "forward")
+	return static_cast<std::int64_t>(course.position * course.depth);
+}
+
+#ifdef AOC_BENCH
+
+static std::int64_t solution_part_1(span<command_t const> commands)
+{
+	return get_part_1_result(follow_course_parallel(commands));
+}
+
+static std::int64_t solution_part_2(span<command_t const> commands)
+{
+	return get_part_2_result(follow_course_parallel(commands));
+}
+
+#endif // AOC_BENCH
+
+// the direction is decided by the name at the start of the line, and the amount starts after it
+// a line with an unknown command is reported, and the program exits, because the standard input
+// of --stream can be anything
+static command_t parse_command(string_view const &line)
+{
+	if (line.starts_with("forward "))
 	{
-		return direction::forward;
+		return { direction::forward, parse_int<std::int32_t>(line.substr(sizeof "forward")) };
 	}
-	else if (dir == "up")
+	else if (line.starts_with("up "))
 	{
-		return direction::up;
+		return { direction::up, parse_int<std::int32_t>(line.substr(sizeof "up")) };
 	}
-	else if (dir == "down")
+	else if (line.starts_with("down "))
 	{
-		return direction::down;
+		return { direction::down, parse_int<std::int32_t>(line.substr(sizeof "down")) };
 	}
-	assert(false);
-	return direction::forward;
+	fmt::print(stderr, "error: unknown command '{}'\n", std::string_view(line));
+	std::exit(1);
 }
 
-static int solution_part_1(span<std::pair<direction, int> const> commands)
+static auto read_input(fs::path const &filename)
 {
-	int position = 0;
-	int depth = 0;
-	for (auto const &[dir, count] : commands)
-	{
-		switch (dir)
-		{
-		case direction::forward:
-			position += count;
-			break;
-		case direction::up:
-			depth -= count;
-			break;
-		case direction::down:
-			depth += count;
-			break;
-		}
-	}
-	return position * depth;
+	return read_file_parallel(filename, &parse_command);
 }
 
-static int solution_part_2(span<std::pair<direction, int> const> commands)
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(2, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+// with "--stream [file]" both parts are solved while reading the file, or the standard input
+// if no file is given, so the input can be piped in and doesn't need to fit into memory
+int main(int argc, char **argv)
 {
-	int position = 0;
-	int aim = 0;
-	int depth = 0;
-	for (auto const &[dir, count] : commands)
+	auto course = course_t{};
+	if (argc >= 2 && argc <= 3 && std::string_view(argv[1]) == "--stream")
 	{
-		switch (dir)
-		{
-		case direction::forward:
-			position += count;
-			depth += aim * count;
-			break;
-		case direction::up:
-			aim -= count;
-			break;
-		case direction::down:
-			aim += count;
-			break;
-		}
+		auto reader = argc == 3 ? line_reader(argv[2]) : line_reader::from_stdin();
+		course = follow_course(stream_lines(reader, &parse_command));
+	}
+	else if (argc == 1)
+	{
+		auto const commands = read_input("input.txt");
+		course = follow_course_parallel(commands);
+	}
+	else
+	{
+		fmt::print(stderr, "usage: {} [--stream [file]]\n", argv[0]);
+		return 1;
 	}
-	return position * depth;
-}
 
-int main(void)
-{
-	auto const commands = read_file("input.txt", [](auto const &line) -> std::pair<direction, int> {
-		auto const space_it = line.find(' ');
-		return { direction_from_string(line.substr(0, space_it)), parse_int<int>(line.substr(space_it + 1, line.size())) };
-	});
-	auto const part_1_result = solution_part_1(commands);
-	fmt::print("part 1: {}\n", part_1_result);
-	auto const part_2_result = solution_part_2(commands);
-	fmt::print("part 2: {}\n", part_2_result);
+	fmt::print("part 1: {}\n", get_part_1_result(course));
+	fmt::print("part 2: {}\n", get_part_2_result(course));
 
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,63 +1,228 @@
 #include "common.h"
 
-static int solution_part_1(span<string const> report)
+namespace
 {
-	auto const gamma_rate = report
-		.transform([](auto const &line) {
-			return line.transform([](auto const c) { return static_cast<std::size_t>(c == '1'); }).template collect<vector>();
-		})
-		.reduce([](auto lhs, auto const &rhs) {
-			for (std::size_t i = 0; i < lhs.size(); ++i)
-			{
-				lhs[i] += rhs[i];
-			}
-			return lhs;
-		})
-		.transform([&report](auto const n) { return static_cast<int>(n > (report.size() / 2));})
-		.reduce([](auto const lhs, auto const rhs) { return (lhs << 1) | rhs; });
-	auto const epsilon_rate = ((1 << report[0].size()) - 1) & ~gamma_rate;
-	return gamma_rate * epsilon_rate;
+
+// the report in two layouts, both with one bit per character:
+//  - rows: every line packed into words_per_row words as a binary number, least significant word first
+//  - columns: bit-sliced, bit r of column j is the j-th character of line r, so the number of ones
+//    in a column is a popcount over words_per_column words
+// lines can be longer than 64 characters; the answers wrap around, so they're exact whenever
+// they fit into 64 bits
+struct report_t
+{
+	std::size_t row_count = 0;
+	std::size_t width = 0;
+	std::size_t words_per_row = 0;
+	std::size_t words_per_column = 0;
+	vector<std::uint64_t> rows;
+	vector<std::uint64_t> columns;
+
+	span<std::uint64_t const> row(std::size_t i) const
+	{ return span<std::uint64_t const>(this->rows.data() + i * this->words_per_row, this->words_per_row); }
+
+	// column j is the j-th character of the lines, which is the most significant bit for j == 0
+	span<std::uint64_t const> column(std::size_t j) const
+	{ return span<std::uint64_t const>(this->columns.data() + j * this->words_per_column, this->words_per_column); }
+
+	// mask of the valid bits of word i of a column
+	std::uint64_t column_word_mask(std::size_t i) const
+	{
+		auto const bit_count = std::min(this->row_count - 64 * i, std::size_t(64));
+		return bit_count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_count) - 1;
+	}
+
+	// mask of the valid bits of word i of a row
+	std::uint64_t row_word_mask(std::size_t i) const
+	{
+		auto const bit_count = std::min(this->width - 64 * i, std::size_t(64));
+		return bit_count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bit_count) - 1;
+	}
+};
+
+static std::size_t count_ones(span<std::uint64_t const> column)
+{
+	return column
+		.transform([](auto const word) { return static_cast<std::size_t>(std::popcount(word)); })
+		.sum();
+}
+
+static std::uint64_t solution_part_1(report_t const &report)
+{
+	vector<std::uint64_t> gamma_rate(report.words_per_row, 0);
+	for (auto const j : utils::iota(std::size_t(0), report.width))
+	{
+		if (count_ones(report.column(j)) > report.row_count / 2)
+		{
+			auto const bit_index = report.width - 1 - j;
+			gamma_rate[bit_index / 64] |= std::uint64_t(1) << (bit_index % 64);
+		}
+	}
+	auto const epsilon_rate = ~gamma_rate[0] & report.row_word_mask(0);
+	return gamma_rate[0] * epsilon_rate;
+}
+
+// whether the lines with ones at the current column should be kept, if only some of them have a one
+static bool keep_ones(std::size_t one_count, std::size_t candidate_count, bool keep_most_common)
+{
+	// ties keep the ones for the most common bits and the zeros for the least common bits
+	return keep_most_common ? 2 * one_count >= candidate_count : 2 * one_count < candidate_count;
 }
 
-static int solution_part_2(span<string const> report)
+// index of the line that remains after filtering by the most or least common bits
+// if every remaining line has the same bit at a column, all of them are kept
+static std::size_t find_rating(report_t const &report, bool keep_most_common)
 {
-	auto oxygen_generator_rating = utils::iota(0, report.size()).collect<vector>();
-	auto scrubber_rating = utils::iota(0, report.size()).collect<vector>();
+	// once this few lines remain they are filtered by their packed rows, instead of
+	// scanning whole columns for every bit
+	constexpr std::size_t max_listed_count = 64;
 
-	for (std::size_t i : utils::iota(0, report[0].size()))
+	// the remaining lines as a bitset in the layout of a column
+	vector<std::uint64_t> candidates(report.words_per_column, 0);
+	for (auto const i : utils::iota(std::size_t(0), report.words_per_column))
 	{
-		if (oxygen_generator_rating.size() == 1 && scrubber_rating.size() == 1)
+		candidates[i] = report.column_word_mask(i);
+	}
+	auto candidate_count = report.row_count;
+
+	auto const count_ones_in_column = [&](std::size_t column_index) {
+		if (column_index == report.width)
+		{
+			return std::size_t(0);
+		}
+		auto const column = report.column(column_index);
+		std::size_t result = 0;
+		for (auto const i : utils::iota(std::size_t(0), report.words_per_column))
 		{
-			break;
+			result += static_cast<std::size_t>(std::popcount(candidates[i] & column[i]));
 		}
-		if (oxygen_generator_rating.size() > 1)
+		return result;
+	};
+
+	std::size_t j = 0;
+	auto one_count = count_ones_in_column(0);
+	for (; j < report.width && candidate_count > max_listed_count; ++j)
+	{
+		if (one_count == 0 || one_count == candidate_count)
 		{
-			auto const one_count = oxygen_generator_rating
-				.transform([&report, i](auto const index) { return static_cast<std::size_t>(report[index][i] == '1'); })
-				.sum();
-			auto const most_common = one_count > (oxygen_generator_rating.size() - 1) / 2 ? '1' : '0';
-			oxygen_generator_rating = oxygen_generator_rating
-				.filter([&report, i, most_common](auto const index) { return report[index][i] == most_common; })
-				.collect<vector>();
+			one_count = count_ones_in_column(j + 1);
+			continue;
 		}
-		if (scrubber_rating.size() > 1)
+
+		// the ones of the next column are counted in the same pass as the filtering
+		auto const column = report.column(j);
+		auto const next_column = j + 1 == report.width ? column : report.column(j + 1);
+		auto const keep_ones_ = keep_ones(one_count, candidate_count, keep_most_common);
+		std::size_t next_one_count = 0;
+		for (auto const i : utils::iota(std::size_t(0), report.words_per_column))
 		{
-			auto const one_count = scrubber_rating
-				.transform([&report, i](auto const index) { return static_cast<std::size_t>(report[index][i] == '1'); })
-				.sum();
-			auto const least_common = one_count > (scrubber_rating.size() - 1) / 2 ? '0' : '1';
-			scrubber_rating = scrubber_rating
-				.filter([&report, i, least_common](auto const index) { return report[index][i] == least_common; })
-				.collect<vector>();
+			candidates[i] &= keep_ones_ ? column[i] : ~column[i];
+			next_one_count += static_cast<std::size_t>(std::popcount(candidates[i] & next_column[i]));
 		}
+		candidate_count = keep_ones_ ? one_count : candidate_count - one_count;
+		one_count = next_one_count;
 	}
 
-	return parse_int_base<int, 2>(report[oxygen_generator_rating[0]]) * parse_int_base<int, 2>(report[scrubber_rating[0]]);
+	if (candidate_count > max_listed_count)
+	{
+		// every column was used, the remaining lines are all the same
+		auto const word_index = static_cast<std::size_t>(
+			std::find_if(candidates.begin(), candidates.end(), [](auto const word) { return word != 0; }) - candidates.begin()
+		);
+		return 64 * word_index + static_cast<std::size_t>(std::countr_zero(candidates[word_index]));
+	}
+
+	std::array<std::size_t, max_listed_count> listed_candidates{};
+	std::size_t listed_count = 0;
+	for (auto const i : utils::iota(std::size_t(0), report.words_per_column))
+	{
+		for (auto word = candidates[i]; word != 0; word &= word - 1)
+		{
+			listed_candidates[listed_count] = 64 * i + static_cast<std::size_t>(std::countr_zero(word));
+			++listed_count;
+		}
+	}
+	assert(listed_count == candidate_count);
+
+	for (; j < report.width && listed_count > 1; ++j)
+	{
+		auto const bit_index = report.width - 1 - j;
+		auto const get_bit = [&report, bit_index](std::size_t row_index) {
+			return (report.row(row_index)[bit_index / 64] >> (bit_index % 64)) & 1;
+		};
+		auto const listed = span<std::size_t>(listed_candidates.data(), listed_count);
+		auto const one_count = listed.transform(get_bit).sum();
+		if (one_count == 0 || one_count == listed_count)
+		{
+			continue;
+		}
+
+		auto const kept_bit = std::uint64_t(keep_ones(one_count, listed_count, keep_most_common) ? 1 : 0);
+		// remove_if keeps the order, so the lowest index remains first like in the bitset
+		auto const kept_end = std::remove_if(listed.begin(), listed.end(), [&](auto const row_index) {
+			return get_bit(row_index) != kept_bit;
+		});
+		listed_count = static_cast<std::size_t>(kept_end - listed.begin());
+	}
+
+	return listed_candidates[0];
+}
+
+static std::uint64_t solution_part_2(report_t const &report)
+{
+	auto const oxygen_generator_rating = report.row(find_rating(report, true))[0];
+	auto const scrubber_rating = report.row(find_rating(report, false))[0];
+	return oxygen_generator_rating * scrubber_rating;
 }
 
+static report_t read_input(fs::path const &filename)
+{
+	auto const data_file = mapped_file(filename);
+	auto const contents = data_file.contents();
+
+	report_t result;
+	for_each_line(contents, [&result](string_view &line) {
+		assert(result.row_count == 0 || line.size() == result.width);
+		result.width = line.size();
+		result.row_count += 1;
+	});
+	result.words_per_row = (result.width + 63) / 64;
+	result.words_per_column = (result.row_count + 63) / 64;
+	result.rows.resize(result.row_count * result.words_per_row, 0);
+	result.columns.resize(result.width * result.words_per_column, 0);
+
+	std::size_t i = 0;
+	for_each_line(contents, [&result, &i](string_view &line) {
+		auto const row = result.rows.data() + i * result.words_per_row;
+		auto const column_word_offset = i / 64;
+		auto const column_bit = std::uint64_t(1) << (i % 64);
+		for (auto const j : utils::iota(std::size_t(0), result.width))
+		{
+			assert(line[j] == '0' || line[j] == '1');
+			if (line[j] == '1')
+			{
+				auto const bit_index = result.width - 1 - j;
+				row[bit_index / 64] |= std::uint64_t(1) << (bit_index % 64);
+				result.columns[j * result.words_per_column + column_word_offset] |= column_bit;
+			}
+		}
+		++i;
+	});
+
+	return result;
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(3, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
-	auto const report = read_file("input.txt", [](auto const &line) { return line; });
+	auto const report = read_input("input.txt");
 	auto const part_1_result = solution_part_1(report);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(report);
@@ -65,3 +230,5 @@ int main(void)
 
 	return 0;
 }
+
+#endif // AOC_BENCH
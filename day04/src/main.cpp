@@ -1,149 +1,299 @@
 #include "common.h"
 #include <array>
 
-struct int_bool_pair_t
+namespace
 {
-	int number;
-	bool is_drawn;
-};
 
-using bingo_board_t = std::array<int_bool_pair_t, 5 * 5>;
+// the boards are stored in blocks of 8, with the numbers of the same cell of the 8 boards next
+// to each other, so the winning draws of a block can be computed with one vector per cell
+inline constexpr std::size_t block_size = 8;
+inline constexpr std::size_t cell_count = 5 * 5;
 
 struct bingo_data_t
 {
 	vector<int> drawn_numbers;
-	vector<bingo_board_t> boards;
+	std::size_t board_count = 0;
+	// largest number on the boards or drawn
+	int max_number = 0;
+	// numbers[(block * cell_count + cell) * block_size + lane] is in board block * block_size + lane,
+	// the boards that fill up the last block have zeros
+	vector<std::int32_t> numbers;
+
+	std::size_t block_count(void) const noexcept
+	{ return (this->board_count + block_size - 1) / block_size; }
+
+	std::int32_t number(std::size_t board_index, std::size_t cell) const noexcept
+	{
+		auto const block = board_index / block_size;
+		auto const lane = board_index % block_size;
+		return this->numbers[(block * cell_count + cell) * block_size + lane];
+	}
 };
 
 static bingo_data_t read_bingo_file(fs::path const &filename)
 {
-	std::ifstream file(filename);
-
-	string line;
-	std::getline(file, line);
-	assert(file);
+	auto const data_file = mapped_file(filename);
+	auto const contents = data_file.contents();
+	auto const first_line_end = std::min(contents.find('\n'), contents.size());
 
 	bingo_data_t result;
+	result.drawn_numbers = parse_ints<int>(contents.substr(0, first_line_end));
+	auto const board_numbers = parse_ints<std::int32_t>(contents.substr(first_line_end));
+	assert(board_numbers.size() % cell_count == 0);
+	assert(result.drawn_numbers.is_all([](auto const number) { return number >= 0; }));
+	assert(board_numbers.is_all([](auto const number) { return number >= 0; }));
 
-	result.drawn_numbers = split_by(line, ",")
-		.transform([](auto const num_str) { return parse_int<int>(num_str); })
-		.collect<vector>();
-
-	while (std::getline(file, line))
+	result.board_count = board_numbers.size() / cell_count;
+	result.max_number = std::max(
+		result.drawn_numbers.empty() ? 0 : result.drawn_numbers.max(),
+		board_numbers.empty() ? 0 : board_numbers.max()
+	);
+	result.numbers.resize(result.block_count() * cell_count * block_size, 0);
+	for (auto const board_index : utils::iota(std::size_t(0), result.board_count))
 	{
-		assert(line == "");
-		result.boards.emplace_back();
-		for (auto const i : utils::iota(0, size_t(5)))
+		auto const block = board_index / block_size;
+		auto const lane = board_index % block_size;
+		for (auto const cell : utils::iota(std::size_t(0), cell_count))
 		{
-			std::getline(file, line);
-			assert(file);
-			std::stringstream ss(line);
-			for (auto const j : utils::iota(0, size_t(5)))
-			{
-				ss >> result.boards.back()[i * 5 + j].number;
-			}
+			result.numbers[(block * cell_count + cell) * block_size + lane] = board_numbers[board_index * cell_count + cell];
 		}
 	}
 
 	return result;
 }
 
-static bool is_winning_board(bingo_board_t const &board)
+static constexpr std::uint32_t never_drawn = std::numeric_limits<std::uint32_t>::max();
+
+// the index of the draw of every number up to max_number, or never_drawn for numbers that aren't drawn
+// a number that is drawn more than once counts from its first draw
+static vector<std::uint32_t> get_draw_indices(bingo_data_t const &bingo_data)
+{
+	auto result = vector<std::uint32_t>(static_cast<std::size_t>(bingo_data.max_number) + 1, never_drawn);
+	for (auto const &[draw_index, number] : bingo_data.drawn_numbers.enumerate())
+	{
+		auto &draw = result[static_cast<std::size_t>(number)];
+		draw = std::min(draw, static_cast<std::uint32_t>(draw_index));
+	}
+	return result;
+}
+
+// a line is completed by the last draw of its numbers, and a board wins with its first completed line
+// returns the winning draws of the 8 boards in a block
+static std::array<std::uint32_t, block_size> get_winning_draws(
+	bingo_data_t const &bingo_data,
+	span<std::uint32_t const> draw_indices,
+	std::size_t block
+)
 {
-	// rows
-	for (auto const i : utils::iota(0, size_t(5)))
+	auto const block_numbers = bingo_data.numbers.data() + block * cell_count * block_size;
+	std::array<std::uint32_t, block_size> result;
+#if AOC_HAS_AVX2
+	__m256i draws[cell_count];
+	for (auto const cell : utils::iota(std::size_t(0), cell_count))
 	{
-		bool is_winning = true;
-		for (auto const j : utils::iota(0, size_t(5)))
+		auto const numbers = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(block_numbers + cell * block_size));
+		draws[cell] = _mm256_i32gather_epi32(reinterpret_cast<int const *>(draw_indices.data()), numbers, 4);
+	}
+
+	auto winning_draws = _mm256_set1_epi32(-1);
+	for (auto const i : utils::iota(std::size_t(0), std::size_t(5)))
+	{
+		auto row_draws = draws[i * 5];
+		auto column_draws = draws[i];
+		for (auto const j : utils::iota(std::size_t(1), std::size_t(5)))
 		{
-			is_winning &= board[i * 5 + j].is_drawn;
+			row_draws = _mm256_max_epu32(row_draws, draws[i * 5 + j]);
+			column_draws = _mm256_max_epu32(column_draws, draws[j * 5 + i]);
 		}
-		if (is_winning)
+		winning_draws = _mm256_min_epu32(winning_draws, _mm256_min_epu32(row_draws, column_draws));
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(result.data()), winning_draws);
+#else
+	std::array<std::array<std::uint32_t, block_size>, cell_count> draws;
+	for (auto const cell : utils::iota(std::size_t(0), cell_count))
+	{
+		for (auto const lane : utils::iota(std::size_t(0), block_size))
 		{
-			return true;
+			draws[cell][lane] = draw_indices[static_cast<std::size_t>(block_numbers[cell * block_size + lane])];
 		}
 	}
 
-	// columns
-	for (auto const j : utils::iota(0, size_t(5)))
+	result.fill(never_drawn);
+	for (auto const i : utils::iota(std::size_t(0), std::size_t(5)))
 	{
-		bool is_winning = true;
-		for (auto const i : utils::iota(0, size_t(5)))
-		{
-			is_winning &= board[i * 5 + j].is_drawn;
-		}
-		if (is_winning)
+		for (auto const lane : utils::iota(std::size_t(0), block_size))
 		{
-			return true;
+			auto row_draw = draws[i * 5][lane];
+			auto column_draw = draws[i][lane];
+			for (auto const j : utils::iota(std::size_t(1), std::size_t(5)))
+			{
+				row_draw = std::max(row_draw, draws[i * 5 + j][lane]);
+				column_draw = std::max(column_draw, draws[j * 5 + i][lane]);
+			}
+			result[lane] = std::min({ result[lane], row_draw, column_draw });
 		}
 	}
+#endif
+	return result;
+}
+
+struct winner_t
+{
+	std::uint32_t draw;
+	std::size_t board_index;
+};
 
-	return false;
+// the first and last winning boards, ties are won by the first board in the input
+struct winners_t
+{
+	winner_t first;
+	winner_t last;
+};
+
+static winners_t combine(winners_t const &lhs, winners_t const &rhs)
+{
+	auto const is_before = [](winner_t const &lhs, winner_t const &rhs) {
+		return lhs.draw < rhs.draw || (lhs.draw == rhs.draw && lhs.board_index < rhs.board_index);
+	};
+	// boards that never win aren't the last winner
+	auto const is_later = [](winner_t const &lhs, winner_t const &rhs) {
+		auto const lhs_draw = lhs.draw == never_drawn ? -1 : std::int64_t(lhs.draw);
+		auto const rhs_draw = rhs.draw == never_drawn ? -1 : std::int64_t(rhs.draw);
+		return lhs_draw > rhs_draw || (lhs_draw == rhs_draw && lhs.board_index < rhs.board_index);
+	};
+	return {
+		is_before(rhs.first, lhs.first) ? rhs.first : lhs.first,
+		is_later(rhs.last, lhs.last) ? rhs.last : lhs.last,
+	};
 }
 
-static int solution_part_1(bingo_data_t bingo_data)
+// the win of every board is computed from the draw indices of its numbers, instead of marking
+// every board for every draw, which gives both winners with one pass over the boards
+static winners_t find_winners(bingo_data_t const &bingo_data, span<std::uint32_t const> draw_indices)
 {
-	for (auto const drawn_num : bingo_data.drawn_numbers)
-	{
-		for (auto &board : bingo_data.boards)
-		{
-			for (auto &[num, is_drawn] : board)
-			{
-				is_drawn |= num == drawn_num;
-			}
-			if (is_winning_board(board))
+	return utils::iota(std::size_t(0), bingo_data.block_count())
+		.transform([&bingo_data, draw_indices](auto const block) {
+			auto const winning_draws = get_winning_draws(bingo_data, draw_indices, block);
+			auto const first_board_index = block * block_size;
+			auto const lane_count = std::min(block_size, bingo_data.board_count - first_board_index);
+			auto const first_winner = winner_t{ winning_draws[0], first_board_index };
+			auto result = winners_t{ first_winner, first_winner };
+			for (auto const lane : utils::iota(std::size_t(1), lane_count))
 			{
-				auto const non_drawn_sum = utils::to_range(board)
-					.filter([](auto const square) { return !square.is_drawn; })
-					.member<&int_bool_pair_t::number>()
-					.sum();
-				return non_drawn_sum * drawn_num;
+				auto const winner = winner_t{ winning_draws[lane], first_board_index + lane };
+				result = combine(result, winners_t{ winner, winner });
 			}
+			return result;
+		})
+		.par()
+		.reduce([](auto const &lhs, auto const &rhs) { return combine(lhs, rhs); });
+}
+
+// masks of the cells of the 5 rows and 5 columns
+static constexpr std::array<std::uint32_t, 10> line_masks = []() {
+	std::array<std::uint32_t, 10> result{};
+	for (std::size_t i = 0; i < 5; ++i)
+	{
+		for (std::size_t j = 0; j < 5; ++j)
+		{
+			result[i] |= std::uint32_t(1) << (i * 5 + j);
+			result[5 + i] |= std::uint32_t(1) << (j * 5 + i);
 		}
 	}
-	return -1;
+	return result;
+}();
+
+// only used to check the winning draws in debug builds
+[[maybe_unused]] static bool is_winning_mask(std::uint32_t marked_mask)
+{
+	return utils::to_range(line_masks).is_any([marked_mask](auto const line_mask) {
+		return (marked_mask & line_mask) == line_mask;
+	});
 }
 
-static int solution_part_2(bingo_data_t bingo_data)
+// 25 bit mask of the cells of a board that are drawn until draw
+static std::uint32_t get_marked_mask(
+	bingo_data_t const &bingo_data,
+	span<std::uint32_t const> draw_indices,
+	std::size_t board_index,
+	std::uint32_t draw
+)
 {
-	for (auto const drawn_num : bingo_data.drawn_numbers)
+	std::uint32_t result = 0;
+	for (auto const cell : utils::iota(std::size_t(0), cell_count))
 	{
-		for (auto &board : bingo_data.boards)
-		{
-			for (auto &[num, is_drawn] : board)
-			{
-				is_drawn |= num == drawn_num;
-			}
-		}
+		auto const number = static_cast<std::size_t>(bingo_data.number(board_index, cell));
+		result |= std::uint32_t(draw_indices[number] <= draw) << cell;
 	}
+	return result;
+}
 
-	for (auto const drawn_num : bingo_data.drawn_numbers.reversed())
+// the sum of the numbers not drawn until the winning draw, times the winning number
+static int get_score(bingo_data_t const &bingo_data, span<std::uint32_t const> draw_indices, winner_t const &winner)
+{
+	if (winner.draw == never_drawn)
 	{
-		for (auto &board : bingo_data.boards)
-		{
-			for (auto &[num, is_drawn] : board)
-			{
-				is_drawn &= !(num == drawn_num);
-			}
-			if (!is_winning_board(board))
-			{
-				auto const non_drawn_sum = utils::to_range(board)
-					.filter([](auto const square) { return !square.is_drawn; })
-					.member<&int_bool_pair_t::number>()
-					.sum() - drawn_num;
-				return non_drawn_sum * drawn_num;
-			}
-		}
+		return -1;
 	}
-	return -1;
+	auto const marked_mask = get_marked_mask(bingo_data, draw_indices, winner.board_index, winner.draw);
+	assert(is_winning_mask(marked_mask));
+	assert(winner.draw == 0 || !is_winning_mask(get_marked_mask(bingo_data, draw_indices, winner.board_index, winner.draw - 1)));
+	auto const non_drawn_sum = utils::iota(std::size_t(0), cell_count)
+		.filter([marked_mask](auto const cell) { return ((marked_mask >> cell) & 1) == 0; })
+		.transform([&](auto const cell) { return bingo_data.number(winner.board_index, cell); })
+		.sum();
+	return non_drawn_sum * bingo_data.drawn_numbers[winner.draw];
 }
 
+struct bingo_scores_t
+{
+	int first_winner_score;
+	int last_winner_score;
+};
+
+static bingo_scores_t play_bingo(bingo_data_t const &bingo_data)
+{
+	if (bingo_data.board_count == 0)
+	{
+		return { -1, -1 };
+	}
+	auto const draw_indices = get_draw_indices(bingo_data);
+	auto const winners = find_winners(bingo_data, draw_indices);
+	return {
+		get_score(bingo_data, draw_indices, winners.first),
+		get_score(bingo_data, draw_indices, winners.last),
+	};
+}
+
+#ifdef AOC_BENCH
+
+static int solution_part_1(bingo_data_t const &bingo_data)
+{
+	return play_bingo(bingo_data).first_winner_score;
+}
+
+static int solution_part_2(bingo_data_t const &bingo_data)
+{
+	return play_bingo(bingo_data).last_winner_score;
+}
+
+#endif // AOC_BENCH
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(4, &read_bingo_file, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
 	auto const bingo_data = read_bingo_file("input.txt");
-	auto const part_1_result = solution_part_1(bingo_data);
+	auto const [part_1_result, part_2_result] = play_bingo(bingo_data);
 	fmt::print("part 1: {}\n", part_1_result);
-	auto const part_2_result = solution_part_2(bingo_data);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,4 +1,9 @@
 #include "common.h"
+#include <array>
+#include <set>
+
+namespace
+{
 
 struct vent_position_t
 {
@@ -8,6 +13,11 @@ struct vent_position_t
 	int y2;
 };
 
+static bool is_axis_aligned(vent_position_t const &vent_position)
+{
+	return vent_position.x1 == vent_position.x2 || vent_position.y1 == vent_position.y2;
+}
+
 static std::pair<int, int> parse_int_pair(std::string_view s)
 {
 	auto const comma_it = s.find(',');
@@ -16,93 +26,603 @@ static std::pair<int, int> parse_int_pair(std::string_view s)
 	return { x, y };
 }
 
-static int solution_part_1(span<vent_position_t const> vent_positions)
+// the lines are grouped by their direction, and every point of a line
+// has the same offset, so the lines are intervals of a parameter at a given offset:
+//  - horizontal: offset y, parameter x
+//  - vertical: offset x, parameter y
+//  - diagonal: offset x - y, parameter x
+//  - anti_diagonal: offset x + y, parameter x
+enum class line_kind : std::uint8_t
+{
+	horizontal,
+	vertical,
+	diagonal,
+	anti_diagonal,
+};
+
+inline constexpr std::size_t line_kind_count = 4;
+
+struct point_t
 {
-	std::size_t const x_size = vent_positions
-		.transform([](auto const pos) { return std::max(pos.x1, pos.x2); })
-		.max() + 1;
-	std::size_t const y_size = vent_positions
-		.transform([](auto const pos) { return std::max(pos.y1, pos.y2); })
-		.max() + 1;
-	vector<int> table;
-	table.resize(x_size * y_size, 0);
-	for (auto const [x1, y1, x2, y2] : vent_positions)
+	int x;
+	int y;
+
+	auto operator <=> (point_t const &other) const = default;
+};
+
+// the points with parameters in [begin, end] of the line at offset
+struct line_interval_t
+{
+	int offset;
+	int begin;
+	int end;
+};
+
+static int get_offset(line_kind kind, point_t p)
+{
+	switch (kind)
 	{
-		if (x1 == x2)
+	case line_kind::horizontal:
+		return p.y;
+	case line_kind::vertical:
+		return p.x;
+	case line_kind::diagonal:
+		return p.x - p.y;
+	case line_kind::anti_diagonal:
+		return p.x + p.y;
+	}
+	assert(false);
+	return 0;
+}
+
+static int get_parameter(line_kind kind, point_t p)
+{
+	return kind == line_kind::vertical ? p.y : p.x;
+}
+
+static point_t get_point(line_kind kind, int offset, int parameter)
+{
+	switch (kind)
+	{
+	case line_kind::horizontal:
+		return { parameter, offset };
+	case line_kind::vertical:
+		return { offset, parameter };
+	case line_kind::diagonal:
+		return { parameter, parameter - offset };
+	case line_kind::anti_diagonal:
+		return { parameter, offset - parameter };
+	}
+	assert(false);
+	return {};
+}
+
+// the lattice point where the lines of two different kinds cross, if there is one
+// the offset of the second kind changes linearly along the first line, by 1, -1 or 2 per step
+static std::optional<point_t> get_crossing(line_kind kind1, int offset1, line_kind kind2, int offset2)
+{
+	assert(kind1 != kind2);
+	auto const offset_at_0 = get_offset(kind2, get_point(kind1, offset1, 0));
+	auto const slope = get_offset(kind2, get_point(kind1, offset1, 1)) - offset_at_0;
+	if ((offset2 - offset_at_0) % slope != 0)
+	{
+		return std::nullopt;
+	}
+	return get_point(kind1, offset1, (offset2 - offset_at_0) / slope);
+}
+
+struct line_set_t
+{
+	// the parts of the lines covered by at least one segment, sorted and disjoint
+	std::array<vector<line_interval_t>, line_kind_count> covered;
+	// the parts of the lines covered by at least two segments of the same line, sorted and disjoint
+	std::array<vector<line_interval_t>, line_kind_count> overlapping;
+};
+
+static bool is_before(line_interval_t const &lhs, line_interval_t const &rhs)
+{
+	return lhs.offset < rhs.offset || (lhs.offset == rhs.offset && lhs.begin < rhs.begin);
+}
+
+// adds interval to the end of intervals, merging it with the last one if they overlap
+static void append_interval(vector<line_interval_t> &intervals, line_interval_t interval)
+{
+	if (
+		!intervals.empty()
+		&& intervals.back().offset == interval.offset
+		&& intervals.back().end >= interval.begin - 1
+	)
+	{
+		intervals.back().end = std::max(intervals.back().end, interval.end);
+	}
+	else
+	{
+		intervals.push_back(interval);
+	}
+}
+
+static bool is_diagonal(line_kind kind)
+{
+	return kind == line_kind::diagonal || kind == line_kind::anti_diagonal;
+}
+
+struct segment_t
+{
+	line_kind kind;
+	line_interval_t interval;
+};
+
+static segment_t get_segment(vent_position_t const &vent_position)
+{
+	auto const [x1, y1, x2, y2] = vent_position;
+	auto const kind = y1 == y2 ? line_kind::horizontal
+		: x1 == x2 ? line_kind::vertical
+		: (x2 - x1 == y2 - y1) ? line_kind::diagonal
+		: line_kind::anti_diagonal;
+	assert(kind != line_kind::anti_diagonal || x2 - x1 == y1 - y2);
+	auto const parameter1 = get_parameter(kind, { x1, y1 });
+	auto const parameter2 = get_parameter(kind, { x2, y2 });
+	return {
+		kind,
+		{ get_offset(kind, { x1, y1 }), std::min(parameter1, parameter2), std::max(parameter1, parameter2) },
+	};
+}
+
+static line_set_t get_line_set(span<vent_position_t const> vent_positions, bool include_diagonals)
+{
+	std::array<vector<line_interval_t>, line_kind_count> segments;
+	for (auto const &vent_position : vent_positions)
+	{
+		auto const [kind, interval] = get_segment(vent_position);
+		if (include_diagonals || !is_diagonal(kind))
 		{
-			auto const y_min = std::min(y1, y2);
-			auto const y_max = std::max(y1, y2);
-			for (int y = y_min; y <= y_max; ++y)
-			{
-				table[y * x_size + x1] += 1;
-			}
+			segments[static_cast<std::size_t>(kind)].push_back(interval);
 		}
-		else if (y1 == y2)
+	}
+
+	line_set_t result;
+	for (auto const kind_index : utils::iota(std::size_t(0), line_kind_count))
+	{
+		auto &kind_segments = segments[kind_index];
+		kind_segments.sort(&is_before);
+		auto &covered = result.covered[kind_index];
+		auto &overlapping = result.overlapping[kind_index];
+		for (auto const &segment : kind_segments)
 		{
-			auto const x_min = std::min(x1, x2);
-			auto const x_max = std::max(x1, x2);
-			for (int x = x_min; x <= x_max; ++x)
+			// every earlier segment of the line begins before this one, so the part of this segment up to
+			// the furthest end of the line so far is covered twice
+			if (!covered.empty() && covered.back().offset == segment.offset && covered.back().end >= segment.begin)
 			{
-				table[y1 * x_size + x] += 1;
+				append_interval(overlapping, { segment.offset, segment.begin, std::min(segment.end, covered.back().end) });
 			}
+			append_interval(covered, segment);
 		}
 	}
+	return result;
+}
+
+// whether one of the sorted, disjoint intervals of the lines of kind contains p
+static bool contains(vector<line_interval_t> const &intervals, line_kind kind, point_t p)
+{
+	auto const key = line_interval_t{ get_offset(kind, p), get_parameter(kind, p), 0 };
+	auto const it = std::upper_bound(intervals.begin(), intervals.end(), key, &is_before);
+	return it != intervals.begin() && (it - 1)->offset == key.offset && (it - 1)->end >= key.begin;
+}
+
+// the number of lines through p that cover it with at least two of their segments
+static std::int64_t count_overlapping_lines(line_set_t const &line_set, point_t p)
+{
+	return static_cast<std::int64_t>(
+		utils::iota(std::size_t(0), line_kind_count)
+			.filter([&](auto const kind_index) {
+				return contains(line_set.overlapping[kind_index], static_cast<line_kind>(kind_index), p);
+			})
+			.count()
+	);
+}
 
-	return table.transform([](auto const n) { return n >= 2 ? 1 : 0; }).sum();
+// whether the crossing p of a line of kind1 and a line of kind2 is where the first two kinds of
+// lines that cover p cross, so that a point where more than two lines meet is counted only once
+// the covered intervals of a kind are disjoint, so a kind has at most one line through p
+static bool is_first_crossing(line_set_t const &line_set, line_kind kind1, line_kind kind2, point_t p)
+{
+	return utils::iota(std::size_t(0), static_cast<std::size_t>(kind2))
+		.filter([kind1](auto const kind_index) { return kind_index != static_cast<std::size_t>(kind1); })
+		.is_all([&](auto const kind_index) {
+			return !contains(line_set.covered[kind_index], static_cast<line_kind>(kind_index), p);
+		});
 }
 
-static int solution_part_2(span<vent_position_t const> vent_positions)
+// the number of crossings of the covered intervals of two kinds of lines, each counted as
+// 1 - count_overlapping_lines, and only at the first crossing of a point
+// the intervals of kind1 are swept in the order of their offsets, with the intervals of kind2 that
+// span the current offset kept in a set ordered by the offset of their lines, so only the pairs
+// that cross are visited
+static std::int64_t count_crossings(line_set_t const &line_set, line_kind kind1, line_kind kind2)
 {
-	std::size_t const x_size = vent_positions
-		.transform([](auto const pos) { return std::max(pos.x1, pos.x2); })
-		.max() + 1;
-	std::size_t const y_size = vent_positions
-		.transform([](auto const pos) { return std::max(pos.y1, pos.y2); })
-		.max() + 1;
-	vector<int> table;
-	table.resize(x_size * y_size, 0);
-	for (auto const [x1, y1, x2, y2] : vent_positions)
+	// the range of the other kind's offset along an interval
+	auto const get_offset_range = [](line_kind kind, line_interval_t const &interval, line_kind other_kind) {
+		auto const begin_offset = get_offset(other_kind, get_point(kind, interval.offset, interval.begin));
+		auto const end_offset = get_offset(other_kind, get_point(kind, interval.offset, interval.end));
+		return std::make_pair(std::min(begin_offset, end_offset), std::max(begin_offset, end_offset));
+	};
+
+	auto const &rows = line_set.covered[static_cast<std::size_t>(kind1)];
+	auto const &columns = line_set.covered[static_cast<std::size_t>(kind2)];
+	if (rows.empty() || columns.empty())
 	{
-		if (x1 == x2)
+		return 0;
+	}
+	// the range of kind1 offsets spanned by every column
+	auto const column_ranges = columns
+		.transform([&](auto const &column) { return get_offset_range(kind2, column, kind1); })
+		.collect<vector>();
+	// the columns are inserted into the set in the order of their first row and erased after their last row
+	auto by_range_begin = utils::iota(std::size_t(0), columns.size()).collect<vector>();
+	by_range_begin.sort([&](auto const lhs, auto const rhs) { return column_ranges[lhs].first < column_ranges[rhs].first; });
+	auto by_range_end = utils::iota(std::size_t(0), columns.size()).collect<vector>();
+	by_range_end.sort([&](auto const lhs, auto const rhs) { return column_ranges[lhs].second < column_ranges[rhs].second; });
+
+	// the active columns as (offset, index) pairs
+	std::set<std::pair<int, std::size_t>> active_columns;
+	std::size_t inserted_count = 0;
+	std::size_t erased_count = 0;
+	std::int64_t result = 0;
+	for (auto const &row : rows)
+	{
+		while (inserted_count < columns.size() && column_ranges[by_range_begin[inserted_count]].first <= row.offset)
+		{
+			auto const column_index = by_range_begin[inserted_count];
+			active_columns.insert({ columns[column_index].offset, column_index });
+			++inserted_count;
+		}
+		while (erased_count < columns.size() && column_ranges[by_range_end[erased_count]].second < row.offset)
+		{
+			auto const column_index = by_range_end[erased_count];
+			active_columns.erase({ columns[column_index].offset, column_index });
+			++erased_count;
+		}
+
+		auto const [offset_begin, offset_end] = get_offset_range(kind1, row, kind2);
+		for (
+			auto it = active_columns.lower_bound({ offset_begin, 0 });
+			it != active_columns.end() && it->first <= offset_end;
+			++it
+		)
 		{
-			auto const y_min = std::min(y1, y2);
-			auto const y_max = std::max(y1, y2);
-			for (int y = y_min; y <= y_max; ++y)
+			auto const crossing = get_crossing(kind1, row.offset, kind2, it->first);
+			if (crossing && is_first_crossing(line_set, kind1, kind2, *crossing))
 			{
-				table[y * x_size + x1] += 1;
+				assert(get_parameter(kind1, *crossing) >= row.begin && get_parameter(kind1, *crossing) <= row.end);
+				// a crossing is already counted once for every overlapping interval that contains it,
+				// and it should be counted exactly once
+				result += 1 - count_overlapping_lines(line_set, *crossing);
 			}
 		}
-		else if (y1 == y2)
+	}
+	return result;
+}
+
+// the number of points covered by at least two lines, without a table of the bounding box
+// a point is covered twice either by two segments of the same line, which are found by merging
+// the sorted segments of every line, or by two crossing lines, whose crossing is computed from
+// their offsets
+// the crossings are counted as they are found, so the memory usage is linear in the number of
+// segments, and the coordinates can be arbitrarily large
+static std::int64_t count_overlaps_sparse(span<vent_position_t const> vent_positions, bool include_diagonals)
+{
+	auto const line_set = get_line_set(vent_positions, include_diagonals);
+
+	auto const overlapping_count = utils::to_range(line_set.overlapping)
+		.transform([](auto const &intervals) {
+			return intervals
+				.transform([](auto const &interval) { return std::int64_t(interval.end) - interval.begin + 1; })
+				.sum();
+		})
+		.sum();
+	std::int64_t crossing_count = 0;
+	for (auto const kind1_index : utils::iota(std::size_t(0), line_kind_count))
+	{
+		for (auto const kind2_index : utils::iota(kind1_index + 1, line_kind_count))
 		{
-			auto const x_min = std::min(x1, x2);
-			auto const x_max = std::max(x1, x2);
-			for (int x = x_min; x <= x_max; ++x)
+			crossing_count += count_crossings(line_set, static_cast<line_kind>(kind1_index), static_cast<line_kind>(kind2_index));
+		}
+	}
+	return overlapping_count + crossing_count;
+}
+
+// the bounding box is split into tiles of tile_size * tile_size points, which are drawn
+// independently, so the threads need no atomics
+// a tile is a 2 bit saturating counter for every point, sliced into a bitset of the points covered
+// at least once and a bitset of the points covered at least twice, which are 16 KiB together,
+// and the points covered twice are counted with popcount
+// the segments are binned in two levels: first into bands, the rows of tiles, and then into
+// the tiles of a band by the thread drawing the band, so that both steps write to few bins
+inline constexpr int tile_size = 256;
+inline constexpr std::size_t tile_word_count = std::size_t(tile_size) * tile_size / 64;
+
+// a rectangle of points, from first to last
+struct box_t
+{
+	std::size_t index;
+	point_t first;
+	point_t last;
+};
+
+// the parameters of the part of segment inside box
+static std::pair<int, int> clip_to_box(segment_t const &segment, box_t const &box)
+{
+	auto const [kind, interval] = segment;
+	switch (kind)
+	{
+	case line_kind::horizontal:
+		return { std::max(interval.begin, box.first.x), std::min(interval.end, box.last.x) };
+	case line_kind::vertical:
+		return { std::max(interval.begin, box.first.y), std::min(interval.end, box.last.y) };
+	case line_kind::diagonal:
+		// y = x - offset
+		return {
+			std::max({ interval.begin, box.first.x, box.first.y + interval.offset }),
+			std::min({ interval.end, box.last.x, box.last.y + interval.offset }),
+		};
+	case line_kind::anti_diagonal:
+		// y = offset - x
+		return {
+			std::max({ interval.begin, box.first.x, interval.offset - box.last.y }),
+			std::min({ interval.end, box.last.x, interval.offset - box.first.y }),
+		};
+	}
+	assert(false);
+	return {};
+}
+
+// calls func(box.index, part) for the parts of segment inside the boxes that it crosses,
+// where get_box(p) is the box containing p
+template<typename GetBox, typename Func>
+static void split_segment(segment_t const &segment, GetBox &&get_box, Func &&func)
+{
+	for (auto parameter = segment.interval.begin; parameter <= segment.interval.end;)
+	{
+		auto const box = get_box(get_point(segment.kind, segment.interval.offset, parameter));
+		auto const [begin, end] = clip_to_box(segment, box);
+		assert(begin == parameter && end >= begin);
+		func(box.index, segment_t{ segment.kind, { segment.interval.offset, begin, end } });
+		parameter = end + 1;
+	}
+}
+
+// the segments of the parts in every bin, binned with a counting sort into one array
+struct bins_t
+{
+	// the segments in bin i are segments[begins[i]] to segments[begins[i + 1]]
+	vector<std::size_t> begins;
+	vector<segment_t> segments;
+
+	span<segment_t const> bin(std::size_t i) const
+	{ return this->segments.slice(this->begins[i], this->begins[i + 1]); }
+};
+
+template<typename Segments, typename GetBox>
+static bins_t get_bins(Segments const &segments, std::size_t bin_count, GetBox &&get_box)
+{
+	bins_t result;
+	result.begins.resize(bin_count + 1, 0);
+	for (auto const &segment : segments)
+	{
+		split_segment(segment, get_box, [&result](auto const bin_index, auto const &) {
+			result.begins[bin_index + 1] += 1;
+		});
+	}
+	for (auto const bin_index : utils::iota(std::size_t(0), bin_count))
+	{
+		result.begins[bin_index + 1] += result.begins[bin_index];
+	}
+	result.segments.resize(result.begins.back(), segment_t{});
+	auto next_positions = result.begins;
+	for (auto const &segment : segments)
+	{
+		split_segment(segment, get_box, [&result, &next_positions](auto const bin_index, auto const &part) {
+			result.segments[next_positions[bin_index]] = part;
+			next_positions[bin_index] += 1;
+		});
+	}
+	return result;
+}
+
+struct tiling_t
+{
+	point_t origin;
+	std::size_t tile_count_x = 0;
+	std::size_t tile_count_y = 0;
+	// the parts of the segments in every band
+	bins_t bands;
+
+	// the band containing p
+	box_t band_box(point_t p) const noexcept
+	{
+		auto const band_index = static_cast<std::size_t>(p.y - this->origin.y) / tile_size;
+		auto const first = point_t{ this->origin.x, this->origin.y + static_cast<int>(band_index) * tile_size };
+		auto const last = point_t{
+			this->origin.x + static_cast<int>(this->tile_count_x) * tile_size - 1,
+			first.y + tile_size - 1,
+		};
+		return { band_index, first, last };
+	}
+
+	// the tile containing p, with its index in its band
+	box_t tile_box(point_t p) const noexcept
+	{
+		auto const tile_x = static_cast<std::size_t>(p.x - this->origin.x) / tile_size;
+		auto const tile_y = static_cast<std::size_t>(p.y - this->origin.y) / tile_size;
+		auto const first = point_t{
+			this->origin.x + static_cast<int>(tile_x) * tile_size,
+			this->origin.y + static_cast<int>(tile_y) * tile_size,
+		};
+		return { tile_x, first, { first.x + tile_size - 1, first.y + tile_size - 1 } };
+	}
+};
+
+static tiling_t get_tiling(span<vent_position_t const> vent_positions, bool include_diagonals)
+{
+	tiling_t result;
+	auto const segments = vent_positions
+		.filter([include_diagonals](auto const &pos) { return include_diagonals || is_axis_aligned(pos); })
+		.transform([](auto const &pos) { return get_segment(pos); })
+		.collect<vector>();
+	if (segments.empty())
+	{
+		result.bands.begins.push_back(0);
+		return result;
+	}
+
+	auto x_min = std::numeric_limits<int>::max();
+	auto x_max = std::numeric_limits<int>::min();
+	auto y_min = std::numeric_limits<int>::max();
+	auto y_max = std::numeric_limits<int>::min();
+	for (auto const &segment : segments)
+	{
+		auto const first = get_point(segment.kind, segment.interval.offset, segment.interval.begin);
+		auto const last = get_point(segment.kind, segment.interval.offset, segment.interval.end);
+		x_min = std::min({ x_min, first.x, last.x });
+		x_max = std::max({ x_max, first.x, last.x });
+		y_min = std::min({ y_min, first.y, last.y });
+		y_max = std::max({ y_max, first.y, last.y });
+	}
+	result.origin = { x_min, y_min };
+	result.tile_count_x = static_cast<std::size_t>(x_max - x_min) / tile_size + 1;
+	result.tile_count_y = static_cast<std::size_t>(y_max - y_min) / tile_size + 1;
+
+	result.bands = get_bins(segments, result.tile_count_y, [&result](point_t p) { return result.band_box(p); });
+	return result;
+}
+
+static std::int64_t count_tile_overlaps(span<segment_t const> segments, point_t tile_origin)
+{
+	// a segment doesn't overlap itself
+	if (segments.size() < 2)
+	{
+		return 0;
+	}
+
+	std::array<std::uint64_t, tile_word_count> covered_once{};
+	std::array<std::uint64_t, tile_word_count> covered_twice{};
+	auto const mark = [&covered_once, &covered_twice](std::size_t word_index, std::uint64_t mask) {
+		covered_twice[word_index] |= covered_once[word_index] & mask;
+		covered_once[word_index] |= mask;
+	};
+
+	for (auto const &segment : segments)
+	{
+		auto const first = get_point(segment.kind, segment.interval.offset, segment.interval.begin);
+		auto const first_bit = static_cast<std::size_t>(first.y - tile_origin.y) * tile_size + static_cast<std::size_t>(first.x - tile_origin.x);
+		auto const length = static_cast<std::size_t>(segment.interval.end - segment.interval.begin) + 1;
+		if (segment.kind == line_kind::horizontal)
+		{
+			// the points of a row are next to each other, so they are marked a word at a time
+			auto const last_bit = first_bit + length - 1;
+			for (auto const word_index : utils::iota(first_bit / 64, last_bit / 64 + 1))
 			{
-				table[y1 * x_size + x] += 1;
+				auto const low_bit = word_index == first_bit / 64 ? first_bit % 64 : 0;
+				auto const high_bit = word_index == last_bit / 64 ? last_bit % 64 : 63;
+				mark(word_index, (~std::uint64_t(0) >> (63 - high_bit)) & (~std::uint64_t(0) << low_bit));
 			}
 		}
 		else
 		{
-			auto const x_min = std::min(x1, x2);
-			auto const x_max = std::max(x1, x2);
-			auto const y_min = x_min == x1 ? y1 : y2;
-			auto const y_max = x_max == x1 ? y1 : y2;
-			auto const y_step = y_max > y_min ? 1 : -1;
-			assert(x_max - x_min == y_step * (y_max - y_min));
-			for (int x = x_min, y = y_min; x <= x_max; ++x, y += y_step)
+			auto const step = segment.kind == line_kind::vertical ? std::size_t(tile_size)
+				: segment.kind == line_kind::diagonal ? std::size_t(tile_size + 1)
+				: std::size_t(1) - std::size_t(tile_size);
+			auto bit = first_bit;
+			for ([[maybe_unused]] auto const _ : utils::iota(std::size_t(0), length))
 			{
-				table[y * x_size + x] += 1;
+				mark(bit / 64, std::uint64_t(1) << (bit % 64));
+				bit += step;
 			}
 		}
 	}
 
-	return table.transform([](auto const n) { return n >= 2 ? 1 : 0; }).sum();
+	return utils::to_range(covered_twice)
+		.transform([](auto const word) { return static_cast<std::int64_t>(std::popcount(word)); })
+		.sum();
 }
 
-int main(void)
+static std::int64_t count_band_overlaps(tiling_t const &tiling, std::size_t band_index)
+{
+	auto const band_segments = tiling.bands.bin(band_index);
+	if (band_segments.size() < 2)
+	{
+		return 0;
+	}
+
+	auto const get_tile_box = [&tiling](point_t p) { return tiling.tile_box(p); };
+	auto const tiles = get_bins(band_segments, tiling.tile_count_x, get_tile_box);
+	auto const band_y = tiling.origin.y + static_cast<int>(band_index) * tile_size;
+	return utils::iota(std::size_t(0), tiling.tile_count_x)
+		.transform([&tiling, &tiles, band_y](auto const tile_x) {
+			auto const tile_origin = point_t{ tiling.origin.x + static_cast<int>(tile_x) * tile_size, band_y };
+			return count_tile_overlaps(tiles.bin(tile_x), tile_origin);
+		})
+		.sum();
+}
+
+// the number of points covered by at least two lines, by drawing the lines into the tiles of the
+// bounding box, which needs no memory for the tiles, only for the binned segments
+static std::int64_t count_overlaps_tiled(span<vent_position_t const> vent_positions, bool include_diagonals)
+{
+	auto const tiling = get_tiling(vent_positions, include_diagonals);
+	auto const count_overlaps_in_band = [&tiling](auto const band_index) {
+		return count_band_overlaps(tiling, band_index);
+	};
+	return utils::iota(std::size_t(0), tiling.tile_count_y).transform(count_overlaps_in_band).par().sum();
+}
+
+static std::int64_t count_overlaps(span<vent_position_t const> vent_positions, bool include_diagonals)
+{
+	if (vent_positions.empty())
+	{
+		return 0;
+	}
+
+	// drawing the tiles is worth it if the lines cover a large part of the bounding box, or if there
+	// are at least as many segments as tiles, so that most of the tiles are drawn anyway
+	// otherwise most of the tiles are empty, and the sparse counter only has a few crossings to find
+	constexpr std::uint64_t max_cells_per_point = 16;
+	constexpr std::uint64_t cells_per_tile = std::uint64_t(tile_size) * tile_size;
+	auto const x_min = vent_positions.transform([](auto const &pos) { return std::min(pos.x1, pos.x2); }).min();
+	auto const x_max = vent_positions.transform([](auto const &pos) { return std::max(pos.x1, pos.x2); }).max();
+	auto const y_min = vent_positions.transform([](auto const &pos) { return std::min(pos.y1, pos.y2); }).min();
+	auto const y_max = vent_positions.transform([](auto const &pos) { return std::max(pos.y1, pos.y2); }).max();
+	auto const cell_count = (static_cast<std::uint64_t>(x_max - x_min) + 1) * (static_cast<std::uint64_t>(y_max - y_min) + 1);
+	auto const point_count = vent_positions
+		.filter([include_diagonals](auto const &pos) { return include_diagonals || is_axis_aligned(pos); })
+		.transform([](auto const &pos) {
+			return static_cast<std::uint64_t>(std::max(std::abs(pos.x2 - pos.x1), std::abs(pos.y2 - pos.y1))) + 1;
+		})
+		.sum();
+	if (cell_count <= max_cells_per_point * point_count || vent_positions.size() >= cell_count / cells_per_tile)
+	{
+		return count_overlaps_tiled(vent_positions, include_diagonals);
+	}
+	else
+	{
+		return count_overlaps_sparse(vent_positions, include_diagonals);
+	}
+}
+
+static std::int64_t solution_part_1(span<vent_position_t const> vent_positions)
+{
+	return count_overlaps(vent_positions, false);
+}
+
+static std::int64_t solution_part_2(span<vent_position_t const> vent_positions)
+{
+	return count_overlaps(vent_positions, true);
+}
+
+static auto read_input(fs::path const &filename)
 {
-	auto const vent_positions = read_file(
-		"input.txt",
+	return read_file_parallel(
+		filename,
 		[](auto const &line_) {
 			std::string_view const line = line_;
 			auto const it = line.find(" -> ");
@@ -112,9 +632,24 @@ int main(void)
 			return vent_position_t{ x1, y1, x2, y2 };
 		}
 	);
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(5, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+int main(void)
+{
+	auto const vent_positions = read_input("input.txt");
 	auto const part_1_result = solution_part_1(vent_positions);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(vent_positions);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -0,0 +1,309 @@
+#ifndef AOC_DAY06_LANTERNFISH_H
+#define AOC_DAY06_LANTERNFISH_H
+
+#include "common.h"
+#include <array>
+
+// lanternfish populations after any number of days, as the powers of the 9x9 transition matrix
+// of the fish counts per timer value
+// the matrices are computed by squaring, so a population after d days needs O(log d) products,
+// with a number type that is chosen by the caller: wrapping integers, integers modulo a constant
+// or big integers
+
+namespace lanternfish
+{
+
+inline constexpr std::size_t timer_count = 9;
+
+template<typename Number>
+using timer_counts_t = std::array<Number, timer_count>;
+
+// integers modulo Modulus
+template<std::uint64_t Modulus>
+struct modular_t
+{
+	static_assert(Modulus > 1);
+#ifndef __SIZEOF_INT128__
+	static_assert(Modulus <= (std::uint64_t(1) << 32), "products need 128 bit integers");
+#endif
+
+	std::uint64_t value = 0;
+
+	modular_t(void) = default;
+
+	modular_t(std::uint64_t value_) noexcept
+		: value(value_ % Modulus)
+	{}
+
+	friend modular_t operator + (modular_t lhs, modular_t rhs) noexcept
+	{
+		modular_t result;
+		result.value = lhs.value >= Modulus - rhs.value ? lhs.value - (Modulus - rhs.value) : lhs.value + rhs.value;
+		return result;
+	}
+
+	friend modular_t operator * (modular_t lhs, modular_t rhs) noexcept
+	{
+		modular_t result;
+#ifdef __SIZEOF_INT128__
+		result.value = static_cast<std::uint64_t>(static_cast<unsigned __int128>(lhs.value) * rhs.value % Modulus);
+#else
+		result.value = lhs.value * rhs.value % Modulus;
+#endif
+		return result;
+	}
+};
+
+// arbitrary precision unsigned integers, with just the operations that the populations need
+struct big_uint_t
+{
+	// base 2^32 digits, least significant first, without leading zeros, so zero has no digits
+	vector<std::uint32_t> digits;
+
+	big_uint_t(void) = default;
+
+	big_uint_t(std::uint64_t value)
+	{
+		for (; value != 0; value >>= 32)
+		{
+			this->digits.push_back(static_cast<std::uint32_t>(value));
+		}
+	}
+
+	friend big_uint_t operator + (big_uint_t const &lhs, big_uint_t const &rhs)
+	{
+		auto const &longer = lhs.digits.size() >= rhs.digits.size() ? lhs : rhs;
+		auto const &shorter = lhs.digits.size() >= rhs.digits.size() ? rhs : lhs;
+		big_uint_t result;
+		result.digits.reserve(longer.digits.size() + 1);
+		std::uint64_t carry = 0;
+		for (auto const i : utils::iota(std::size_t(0), longer.digits.size()))
+		{
+			auto const sum = carry + longer.digits[i] + (i < shorter.digits.size() ? shorter.digits[i] : 0);
+			result.digits.push_back(static_cast<std::uint32_t>(sum));
+			carry = sum >> 32;
+		}
+		if (carry != 0)
+		{
+			result.digits.push_back(static_cast<std::uint32_t>(carry));
+		}
+		return result;
+	}
+
+	friend big_uint_t operator * (big_uint_t const &lhs, big_uint_t const &rhs)
+	{
+		big_uint_t result;
+		if (lhs.digits.empty() || rhs.digits.empty())
+		{
+			return result;
+		}
+		result.digits.resize(lhs.digits.size() + rhs.digits.size(), 0);
+		for (auto const i : utils::iota(std::size_t(0), lhs.digits.size()))
+		{
+			std::uint64_t carry = 0;
+			for (auto const j : utils::iota(std::size_t(0), rhs.digits.size()))
+			{
+				auto const product = std::uint64_t(lhs.digits[i]) * rhs.digits[j] + result.digits[i + j] + carry;
+				result.digits[i + j] = static_cast<std::uint32_t>(product);
+				carry = product >> 32;
+			}
+			result.digits[i + rhs.digits.size()] = static_cast<std::uint32_t>(carry);
+		}
+		if (result.digits.back() == 0)
+		{
+			result.digits.pop_back();
+		}
+		return result;
+	}
+
+	std::string to_string(void) const
+	{
+		if (this->digits.empty())
+		{
+			return "0";
+		}
+
+		// the number is divided by 10^9 until it's zero, which gives 9 decimal digits at a time
+		constexpr std::uint32_t decimal_base = 1'000'000'000;
+		auto remaining = this->digits;
+		vector<std::uint32_t> decimal_digits;
+		while (!remaining.empty())
+		{
+			std::uint64_t remainder = 0;
+			for (auto &digit : remaining.reversed())
+			{
+				auto const value = (remainder << 32) | digit;
+				digit = static_cast<std::uint32_t>(value / decimal_base);
+				remainder = value % decimal_base;
+			}
+			decimal_digits.push_back(static_cast<std::uint32_t>(remainder));
+			while (!remaining.empty() && remaining.back() == 0)
+			{
+				remaining.pop_back();
+			}
+		}
+
+		auto result = fmt::format("{}", decimal_digits.back());
+		for (auto const i : utils::iota(std::size_t(1), decimal_digits.size()))
+		{
+			result += fmt::format("{:09}", decimal_digits[decimal_digits.size() - 1 - i]);
+		}
+		return result;
+	}
+};
+
+template<std::uint64_t Modulus>
+inline std::string to_string(modular_t<Modulus> const &number)
+{
+	return fmt::format("{}", number.value);
+}
+
+inline std::string to_string(big_uint_t const &number)
+{
+	return number.to_string();
+}
+
+// the built in integers, including 128 bit ones, which wrap around
+template<typename Number>
+inline std::string to_string(Number const &number)
+{
+	return fmt::format("{}", number);
+}
+
+template<typename Number>
+struct matrix_t
+{
+	// values[i * timer_count + j] is the number of fish with timer i made by a fish with timer j
+	std::array<Number, timer_count * timer_count> values;
+
+	Number &operator () (std::size_t i, std::size_t j)
+	{ return this->values[i * timer_count + j]; }
+
+	Number const &operator () (std::size_t i, std::size_t j) const
+	{ return this->values[i * timer_count + j]; }
+
+	friend matrix_t operator * (matrix_t const &lhs, matrix_t const &rhs)
+	{
+		matrix_t result;
+		for (auto const i : utils::iota(std::size_t(0), timer_count))
+		{
+			for (auto const j : utils::iota(std::size_t(0), timer_count))
+			{
+				auto sum = Number(0);
+				for (auto const k : utils::iota(std::size_t(0), timer_count))
+				{
+					sum = sum + lhs(i, k) * rhs(k, j);
+				}
+				result(i, j) = std::move(sum);
+			}
+		}
+		return result;
+	}
+};
+
+// the fish counts per timer after one day: every timer goes down by one, and a fish at zero
+// goes back to 6 and makes a new fish at 8
+template<typename Number>
+matrix_t<Number> get_transition_matrix(void)
+{
+	matrix_t<Number> result;
+	result.values.fill(Number(0));
+	for (auto const i : utils::iota(std::size_t(0), timer_count - 1))
+	{
+		result(i, i + 1) = Number(1);
+	}
+	result(6, 0) = Number(1);
+	result(8, 0) = Number(1);
+	return result;
+}
+
+// number of fish with every timer value
+inline timer_counts_t<std::uint64_t> get_timer_histogram(span<int const> fish_timers)
+{
+	timer_counts_t<std::uint64_t> result{};
+	for (auto const timer : fish_timers)
+	{
+		assert(timer >= 0 && static_cast<std::size_t>(timer) < timer_count);
+		result[static_cast<std::size_t>(timer)] += 1;
+	}
+	return result;
+}
+
+// the powers of two of the transition matrix up to a number of days, from which the population
+// after any number of days up to that is given with one vector-matrix product per set bit of the days
+template<typename Number>
+struct population_model_t
+{
+private:
+	// _powers[k] is the transition matrix to the power of 2^k
+	vector<matrix_t<Number>> _powers;
+
+public:
+	explicit population_model_t(std::uint64_t max_days)
+	{
+		auto const power_count = std::max(static_cast<std::size_t>(std::bit_width(max_days)), std::size_t(1));
+		this->_powers.reserve(power_count);
+		this->_powers.push_back(get_transition_matrix<Number>());
+		while (this->_powers.size() < power_count)
+		{
+			this->_powers.push_back(this->_powers.back() * this->_powers.back());
+		}
+	}
+
+	std::uint64_t max_days(void) const noexcept
+	{
+		return this->_powers.size() == 64 ? std::numeric_limits<std::uint64_t>::max() : (std::uint64_t(1) << this->_powers.size()) - 1;
+	}
+
+	// result[t] is the number of fish after days, starting from one fish with timer t
+	timer_counts_t<Number> get_descendant_counts(std::uint64_t days) const
+	{
+		assert(days <= this->max_days());
+		// the row vector of ones is multiplied by the powers of the set bits, which commute
+		timer_counts_t<Number> result;
+		result.fill(Number(1));
+		for (std::size_t k = 0; days != 0; ++k, days >>= 1)
+		{
+			if ((days & 1) == 0)
+			{
+				continue;
+			}
+			auto const &power = this->_powers[k];
+			timer_counts_t<Number> product;
+			for (auto const j : utils::iota(std::size_t(0), timer_count))
+			{
+				auto sum = Number(0);
+				for (auto const i : utils::iota(std::size_t(0), timer_count))
+				{
+					sum = sum + result[i] * power(i, j);
+				}
+				product[j] = std::move(sum);
+			}
+			result = std::move(product);
+		}
+		return result;
+	}
+
+	Number get_fish_count(timer_counts_t<std::uint64_t> const &timer_histogram, std::uint64_t days) const
+	{
+		auto const descendant_counts = this->get_descendant_counts(days);
+		auto result = Number(0);
+		for (auto const timer : utils::iota(std::size_t(0), timer_count))
+		{
+			result = result + Number(timer_histogram[timer]) * descendant_counts[timer];
+		}
+		return result;
+	}
+
+	// get_fish_count for every element of days
+	vector<Number> get_fish_counts(timer_counts_t<std::uint64_t> const &timer_histogram, span<std::uint64_t const> days) const
+	{
+		return days
+			.transform([this, &timer_histogram](auto const days_) { return this->get_fish_count(timer_histogram, days_); })
+			.template collect<vector>();
+	}
+};
+
+} // namespace lanternfish
+
+#endif // AOC_DAY06_LANTERNFISH_H
@@ -1,6 +1,10 @@
 #include "common.h"
+#include "lanternfish.h"
 
-static std::size_t get_fish_count(span<int const> initial_fish_timers, std::size_t days)
+namespace
+{
+
+static constexpr std::size_t get_fish_count(span<int const> initial_fish_timers, std::size_t days)
 {
 	std::size_t fish_count = initial_fish_timers.size();
 	std::array<std::size_t, 9> new_fishes_each_day{};
@@ -9,7 +13,7 @@ static std::size_t get_fish_count(span<int const> initial_fish_timers, std::size
 		new_fishes_each_day[time] += 1;
 	}
 
-	for ([[maybe_unused]] auto const day : utils::iota(0, days))
+	for (std::size_t day = 0; day < days; ++day)
 	{
 		auto const new_fish_count = new_fishes_each_day[0];
 		std::copy_n(new_fishes_each_day.begin() + 1, new_fishes_each_day.size() - 1, new_fishes_each_day.begin());
@@ -20,29 +24,165 @@ static std::size_t get_fish_count(span<int const> initial_fish_timers, std::size
 	return fish_count;
 }
 
+// the numbers of days with a precomputed row in fish_table
+inline constexpr std::array<std::size_t, 2> table_days = { 80, 256 };
+
+// result[i][t] is the number of fish after days[i] days, starting from one fish with timer t
+// a fish with timer t > 0 has the descendants of a fish with timer t - 1 one day later, and a fish
+// with timer 0 has the descendants of a fish with timer 6 and one with timer 8
+template<std::size_t N>
+static constexpr std::array<std::array<std::size_t, 9>, N> get_fish_table(std::array<std::size_t, N> const &days)
+{
+	std::array<std::array<std::size_t, 9>, N> result{};
+	for (std::size_t i = 0; i < N; ++i)
+	{
+		std::array<std::size_t, 9> descendant_counts{};
+		descendant_counts.fill(1);
+		for (std::size_t day = 0; day < days[i]; ++day)
+		{
+			auto const zero_count = descendant_counts[6] + descendant_counts[8];
+			std::copy_backward(descendant_counts.begin(), descendant_counts.end() - 1, descendant_counts.end());
+			descendant_counts[0] = zero_count;
+		}
+		result[i] = descendant_counts;
+	}
+	return result;
+}
+
+// the fish counts don't depend on the input, so they are generated at compile time, and the
+// population after one of table_days is a dot product with the timer histogram
+inline constexpr auto fish_table = get_fish_table(table_days);
+
+static constexpr bool is_fish_table_correct(void)
+{
+	for (std::size_t i = 0; i < table_days.size(); ++i)
+	{
+		for (int timer = 0; timer < 9; ++timer)
+		{
+			if (fish_table[i][static_cast<std::size_t>(timer)] != get_fish_count(span<int const>(&timer, 1), table_days[i]))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static_assert(is_fish_table_correct());
+
+static constexpr std::size_t get_table_index(std::size_t days)
+{
+	for (std::size_t i = 0; i < table_days.size(); ++i)
+	{
+		if (table_days[i] == days)
+		{
+			return i;
+		}
+	}
+	return table_days.size();
+}
+
+template<std::size_t Days>
+static std::size_t get_table_fish_count(span<int const> fish_timers)
+{
+	constexpr auto table_index = get_table_index(Days);
+	static_assert(table_index < table_days.size(), "Days must be in table_days");
+	auto const timer_histogram = lanternfish::get_timer_histogram(fish_timers);
+	std::size_t result = 0;
+	for (auto const timer : utils::iota(std::size_t(0), lanternfish::timer_count))
+	{
+		result += timer_histogram[timer] * fish_table[table_index][timer];
+	}
+	return result;
+}
+
 static std::size_t solution_part_1(span<int const> fish_timers)
 {
-	return get_fish_count(fish_timers, 80);
+	return get_table_fish_count<80>(fish_timers);
 }
 
 static std::size_t solution_part_2(span<int const> fish_timers)
 {
-	return get_fish_count(fish_timers, 256);
+	return get_table_fish_count<256>(fish_timers);
 }
 
-int main(void)
+static auto read_input(fs::path const &filename)
 {
-	auto const fish_timers = read_file(
-		"input.txt",
-		[](auto const &line) {
-			return split_by(line, ",")
-			.transform([](auto const s) { return parse_int<int>(s); })
-			.template collect<vector>();
-		}
+	return read_file(
+		filename,
+		[](auto const &line) { return parse_ints<int>(line); }
 	).front();
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(6, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+template<typename Number>
+static void print_fish_counts(span<int const> fish_timers, span<std::uint64_t const> days)
+{
+	auto const model = lanternfish::population_model_t<Number>(days.max());
+	auto const fish_counts = model.get_fish_counts(lanternfish::get_timer_histogram(fish_timers), days);
+	for (auto const &[index, fish_count] : fish_counts.enumerate())
+	{
+		fmt::print("{}: {}\n", days[index], lanternfish::to_string(fish_count));
+	}
+}
+
+// with "--days <number type> <days>..." the fish counts after every given number of days are
+// printed, the number types are:
+//  - u64: 64 bit integers, which wrap around
+//  - mod: integers modulo 10^9 + 7
+//  - u128: 128 bit integers, which wrap around
+//  - big: exact, which needs O(days) memory
+int main(int argc, char **argv)
+{
+	if (argc >= 4 && std::string_view(argv[1]) == "--days")
+	{
+		auto const fish_timers = read_input("input.txt");
+		auto const number_type = std::string_view(argv[2]);
+		auto const days = utils::iota(3, argc)
+			.transform([argv](auto const i) { return parse_int<std::uint64_t>(std::string_view(argv[i])); })
+			.collect<vector>();
+		if (number_type == "u64")
+		{
+			print_fish_counts<std::uint64_t>(fish_timers, days);
+			return 0;
+		}
+		else if (number_type == "mod")
+		{
+			print_fish_counts<lanternfish::modular_t<1'000'000'007>>(fish_timers, days);
+			return 0;
+		}
+#ifdef __SIZEOF_INT128__
+		else if (number_type == "u128")
+		{
+			print_fish_counts<unsigned __int128>(fish_timers, days);
+			return 0;
+		}
+#endif
+		else if (number_type == "big")
+		{
+			print_fish_counts<lanternfish::big_uint_t>(fish_timers, days);
+			return 0;
+		}
+	}
+	if (argc != 1)
+	{
+		fmt::print(stderr, "usage: {} [--days <u64|mod|u128|big> <days>...]\n", argv[0]);
+		return 1;
+	}
+
+	auto const fish_timers = read_input("input.txt");
 	auto const part_1_result = solution_part_1(fish_timers);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(fish_timers);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
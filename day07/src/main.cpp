@@ -1,52 +1,364 @@
 #include "common.h"
 
-static int calculate_fuel_cost_1(span<int const> horizontal_positions, int position)
+namespace
 {
-	return horizontal_positions.transform([position](auto const pos) { return std::abs(pos - position); }).sum();
+
+#ifdef __SIZEOF_INT128__
+// the triangular costs of many crabs over large distances don't fit into 64 bits
+using triangular_cost_t = __int128;
+// the sums the triangular costs are evaluated from
+using triangular_sum_t = __int128;
+#else
+// the sums wrap around, and the costs are exact whenever the doubled costs fit into 64 bits, which
+// holds for up to 2^64 / range^2 crabs with positions in a range
+using triangular_cost_t = std::int64_t;
+using triangular_sum_t = std::uint64_t;
+#endif
+
+// the positions sorted, with their prefix sums, so the cost of moving every crab to a position
+// is given by a binary search
+struct sorted_positions_t
+{
+	vector<int> positions;
+	// prefix_sums[i] is the sum of the first i positions
+	vector<std::int64_t> prefix_sums;
+	triangular_sum_t square_sum = 0;
+};
+
+static sorted_positions_t get_sorted_positions(span<int const> horizontal_positions)
+{
+	sorted_positions_t result;
+	result.positions = horizontal_positions.as_range().collect<vector>();
+	result.positions.sort();
+	result.prefix_sums.reserve(result.positions.size() + 1);
+	result.prefix_sums.push_back(0);
+	for (auto const pos : result.positions)
+	{
+		result.prefix_sums.push_back(result.prefix_sums.back() + pos);
+		result.square_sum += triangular_sum_t(pos) * triangular_sum_t(pos);
+	}
+	return result;
+}
+
+// the sum of the distances to position: the positions below it are subtracted from it, and it is
+// subtracted from the positions above it
+static std::int64_t get_linear_cost(sorted_positions_t const &sorted_positions, int position)
+{
+	auto const &positions = sorted_positions.positions;
+	auto const &prefix_sums = sorted_positions.prefix_sums;
+	auto const below_count = static_cast<std::size_t>(
+		std::lower_bound(positions.begin(), positions.end(), position) - positions.begin()
+	);
+	auto const above_count = positions.size() - below_count;
+	auto const below_sum = prefix_sums[below_count];
+	auto const above_sum = prefix_sums.back() - below_sum;
+	return std::int64_t(position) * static_cast<std::int64_t>(below_count) - below_sum
+		+ above_sum - std::int64_t(position) * static_cast<std::int64_t>(above_count);
+}
+
+// the sum of d * (d + 1) / 2 for the distances d to position, which is half of the sum of
+// the squared distances and the linear cost
+static triangular_cost_t get_triangular_cost(sorted_positions_t const &sorted_positions, int position)
+{
+	auto const count = static_cast<triangular_sum_t>(sorted_positions.positions.size());
+	auto const sum = static_cast<triangular_sum_t>(sorted_positions.prefix_sums.back());
+	auto const pos = static_cast<triangular_sum_t>(position);
+	auto const squared_distance_sum = sorted_positions.square_sum - 2 * sum * pos + count * pos * pos;
+	auto const linear_cost = static_cast<triangular_sum_t>(get_linear_cost(sorted_positions, position));
+	return static_cast<triangular_cost_t>((squared_distance_sum + linear_cost) / 2);
+}
+
+// the linear cost is minimal at the median
+static std::int64_t get_min_linear_cost(sorted_positions_t const &sorted_positions)
+{
+	if (sorted_positions.positions.empty())
+	{
+		return 0;
+	}
+	auto const &positions = sorted_positions.positions;
+	return get_linear_cost(sorted_positions, positions[(positions.size() - 1) / 2]);
+}
+
+// the derivative of the triangular cost is the count times the distance from the mean, plus half of
+// the difference of the counts below and above, so the minimum is within 1/2 of the mean, and
+// only the integers around it need to be checked
+static triangular_cost_t get_min_triangular_cost(sorted_positions_t const &sorted_positions)
+{
+	if (sorted_positions.positions.empty())
+	{
+		return 0;
+	}
+	auto const &positions = sorted_positions.positions;
+	auto const count = static_cast<std::int64_t>(positions.size());
+	auto const sum = sorted_positions.prefix_sums.back();
+	// rounded down, also for negative sums
+	auto const mean = static_cast<int>(sum / count - (sum % count < 0 ? 1 : 0));
+	auto const first = std::max(mean - 1, positions.front());
+	auto const last = std::min(mean + 2, positions.back());
+	return utils::iota(first, last + 1)
+		.transform([&sorted_positions](auto const pos) { return get_triangular_cost(sorted_positions, pos); })
+		.min();
+}
+
+// in place prefix sums, which wrap around
+static void inclusive_scan(span<std::uint64_t> values)
+{
+	std::size_t i = 0;
+#if AOC_HAS_AVX2
+	// the sums of 4 values are computed by adding the vector shifted up by one and then by two lanes,
+	// and the last sum is carried into the next 4 values
+	auto const zero = _mm256_setzero_si256();
+	auto carry = _mm256_setzero_si256();
+	for (; i + 4 <= values.size(); i += 4)
+	{
+		auto sums = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values.data() + i));
+		sums = _mm256_add_epi64(sums, _mm256_blend_epi32(_mm256_permute4x64_epi64(sums, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+		sums = _mm256_add_epi64(sums, _mm256_blend_epi32(_mm256_permute4x64_epi64(sums, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0f));
+		sums = _mm256_add_epi64(sums, carry);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(values.data() + i), sums);
+		carry = _mm256_permute4x64_epi64(sums, _MM_SHUFFLE(3, 3, 3, 3));
+	}
+#endif
+	auto sum = i == 0 ? std::uint64_t(0) : values[i - 1];
+	for (; i < values.size(); ++i)
+	{
+		sum += values[i];
+		values[i] = sum;
+	}
 }
 
-static int solution_part_1(span<int const> horizontal_positions)
+// the costs of moving every crab to each position from the first to the last crab
+// the costs wrap around, so they're exact whenever they fit into 64 bits
+struct cost_curves_t
+{
+	int first_position = 0;
+	// linear[i] and triangular[i] are the costs at first_position + i
+	vector<std::int64_t> linear;
+	vector<std::int64_t> triangular;
+};
+
+// the crabs are counted at every position, and the running sums of the counts and of the distances
+// from the first position give the number and distance sum of the crabs up to every position
+// from those, the cost at a position doesn't depend on the cost at the previous one, so the
+// curves are computed with vectors, in O(n + range)
+static cost_curves_t get_cost_curves(span<int const> horizontal_positions)
 {
+	cost_curves_t result;
+	if (horizontal_positions.empty())
+	{
+		return result;
+	}
+
 	auto const min = horizontal_positions.min();
 	auto const max = horizontal_positions.max();
-	return utils::iota(min, max)
-		.transform([horizontal_positions](auto const pos) { return calculate_fuel_cost_1(horizontal_positions, pos); })
-		.min();
+	auto const size = static_cast<std::size_t>(max - min) + 1;
+	result.first_position = min;
+
+	// counts[i] is the number of crabs at min + i, and distance_sums[i] their distance from min
+	vector<std::uint64_t> counts(size, 0);
+	std::uint64_t square_sum = 0;
+	for (auto const pos : horizontal_positions)
+	{
+		auto const distance = static_cast<std::uint64_t>(pos - min);
+		counts[distance] += 1;
+		square_sum += distance * distance;
+	}
+	vector<std::uint64_t> distance_sums(size, 0);
+	for (auto const i : utils::iota(std::size_t(0), size))
+	{
+		distance_sums[i] = counts[i] * i;
+	}
+	inclusive_scan(counts);
+	inclusive_scan(distance_sums);
+
+	auto const count = counts.back();
+	auto const distance_sum = distance_sums.back();
+	result.linear.resize(size, 0);
+	result.triangular.resize(size, 0);
+	for (auto const i : utils::iota(std::size_t(0), size))
+	{
+		// the crabs up to min + i are subtracted from it, and it is subtracted from the crabs above it
+		auto const below_count = counts[i];
+		auto const below_sum = distance_sums[i];
+		auto const linear = 2 * (i * below_count - below_sum) + distance_sum - i * count;
+		// half of the sum of the squared distances and the linear cost
+		auto const squared_distance_sum = square_sum - 2 * i * distance_sum + count * i * i;
+		result.linear[i] = static_cast<std::int64_t>(linear);
+		result.triangular[i] = static_cast<std::int64_t>((squared_distance_sum + linear) / 2);
+	}
+	return result;
+}
+
+struct min_costs_t
+{
+	std::int64_t linear;
+	triangular_cost_t triangular;
+};
+
+// the cost curves take memory for every position between the first and last crab, so they are only
+// computed if the positions are dense, and their costs are only exact if they fit into 64 bits
+static bool can_use_cost_curves(span<int const> horizontal_positions)
+{
+	if (horizontal_positions.empty())
+	{
+		return false;
+	}
+
+	constexpr std::size_t max_range_per_crab = 4;
+	auto const min = horizontal_positions.min();
+	auto const max = horizontal_positions.max();
+	auto const range = static_cast<std::size_t>(max - min) + 1;
+	// the doubled triangular cost of a crab is at most (range - 1) * range, and their sum has to fit
+	// into 64 bits, because it is halved after wrapping around
+	auto const max_doubled_crab_cost = static_cast<std::uint64_t>(range - 1) * range;
+	auto const do_costs_fit = max_doubled_crab_cost == 0
+		|| horizontal_positions.size() <= std::numeric_limits<std::uint64_t>::max() / max_doubled_crab_cost;
+	return range <= max_range_per_crab * horizontal_positions.size() && do_costs_fit;
+}
+
+// the cost curves are used if they can be, otherwise the median and the mean of the sorted positions
+static min_costs_t get_min_costs(span<int const> horizontal_positions)
+{
+	if (horizontal_positions.empty())
+	{
+		return { 0, 0 };
+	}
+
+	if (can_use_cost_curves(horizontal_positions))
+	{
+		auto const cost_curves = get_cost_curves(horizontal_positions);
+		return { cost_curves.linear.min(), cost_curves.triangular.min() };
+	}
+
+	auto const sorted_positions = get_sorted_positions(horizontal_positions);
+	return { get_min_linear_cost(sorted_positions), get_min_triangular_cost(sorted_positions) };
 }
 
-static int calculate_fuel_cost_2(int a, int b)
+#ifdef AOC_BENCH
+
+static std::int64_t solution_part_1(span<int const> horizontal_positions)
 {
-	auto const diff = std::abs(a - b);
-	return (diff * (diff + 1)) / 2;
+	return get_min_costs(horizontal_positions).linear;
 }
 
-static int calculate_fuel_cost_2(span<int const> horizontal_positions, int position)
+static triangular_cost_t solution_part_2(span<int const> horizontal_positions)
 {
-	return horizontal_positions.transform([position](auto const pos) { return calculate_fuel_cost_2(pos, position); }).sum();
+	return get_min_costs(horizontal_positions).triangular;
 }
 
-static int solution_part_2(span<int const> horizontal_positions)
+#else
+
+// the costs at every position between the first and last crab, only used to verify the results
+static std::int64_t get_min_linear_cost_brute_force(span<int const> horizontal_positions)
 {
 	auto const min = horizontal_positions.min();
 	auto const max = horizontal_positions.max();
-	return utils::iota(min, max)
-		.transform([horizontal_positions](auto const pos) { return calculate_fuel_cost_2(horizontal_positions, pos); })
+	return utils::iota(min, max + 1)
+		.transform([horizontal_positions](auto const position) {
+			return horizontal_positions
+				.transform([position](auto const pos) { return std::int64_t(std::abs(pos - position)); })
+				.sum();
+		})
+		.par()
 		.min();
 }
 
-int main(void)
+static triangular_cost_t get_min_triangular_cost_brute_force(span<int const> horizontal_positions)
 {
-	auto const horizontal_positions = read_file(
-		"input.txt",
-		[](auto const &line) {
-			return split_by(line, ",")
-			.transform([](auto const s) { return parse_int<int>(s); })
-			.template collect<vector>();
-		}
+	auto const min = horizontal_positions.min();
+	auto const max = horizontal_positions.max();
+	return utils::iota(min, max + 1)
+		.transform([horizontal_positions](auto const position) {
+			return horizontal_positions
+				.transform([position](auto const pos) {
+					auto const distance = std::int64_t(std::abs(pos - position));
+					return triangular_cost_t(distance * (distance + 1) / 2);
+				})
+				.sum();
+		})
+		.par()
+		.min();
+}
+
+#endif // AOC_BENCH
+
+static auto read_input(fs::path const &filename)
+{
+	return read_file(
+		filename,
+		[](auto const &line) { return parse_ints<int>(line); }
 	).front();
-	auto const part_1_result = solution_part_1(horizontal_positions);
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(7, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+// with "--verify" the results are also computed by trying every position, and compared
+// with "--curves" the linear and triangular costs at every position are printed
+int main(int argc, char **argv)
+{
+	auto const verify = argc == 2 && std::string_view(argv[1]) == "--verify";
+	auto const print_curves = argc == 2 && std::string_view(argv[1]) == "--curves";
+	if (argc != 1 && !verify && !print_curves)
+	{
+		fmt::print(stderr, "usage: {} [--verify | --curves]\n", argv[0]);
+		return 1;
+	}
+
+	auto const horizontal_positions = read_input("input.txt");
+	if (print_curves)
+	{
+		if (!can_use_cost_curves(horizontal_positions))
+		{
+			fmt::print(stderr, "error: the positions are too sparse or too far apart for the cost curves\n");
+			return 1;
+		}
+		auto const cost_curves = get_cost_curves(horizontal_positions);
+		fmt::print("position,linear,triangular\n");
+		for (auto const i : utils::iota(std::size_t(0), cost_curves.linear.size()))
+		{
+			fmt::print(
+				"{},{},{}\n",
+				cost_curves.first_position + static_cast<int>(i), cost_curves.linear[i], cost_curves.triangular[i]
+			);
+		}
+		return 0;
+	}
+
+	auto const [part_1_result, part_2_result] = get_min_costs(horizontal_positions);
 	fmt::print("part 1: {}\n", part_1_result);
-	auto const part_2_result = solution_part_2(horizontal_positions);
 	fmt::print("part 2: {}\n", part_2_result);
+
+	if (verify && !horizontal_positions.empty())
+	{
+		// both ways of finding the minimums are checked, whichever one get_min_costs used, except the
+		// cost curves if they can't be used
+		auto const sorted_positions = get_sorted_positions(horizontal_positions);
+		auto const cost_curves = can_use_cost_curves(horizontal_positions)
+			? std::optional(get_cost_curves(horizontal_positions))
+			: std::nullopt;
+		auto const part_1_brute_force_result = get_min_linear_cost_brute_force(horizontal_positions);
+		auto const part_2_brute_force_result = get_min_triangular_cost_brute_force(horizontal_positions);
+		auto const is_part_1_correct = get_min_linear_cost(sorted_positions) == part_1_brute_force_result
+			&& (!cost_curves || cost_curves->linear.min() == part_1_brute_force_result);
+		auto const is_part_2_correct = get_min_triangular_cost(sorted_positions) == part_2_brute_force_result
+			&& (!cost_curves || cost_curves->triangular.min() == part_2_brute_force_result);
+		if (!is_part_1_correct || !is_part_2_correct)
+		{
+			fmt::print(
+				stderr, "error: the results of trying every position are {} and {}\n",
+				part_1_brute_force_result, part_2_brute_force_result
+			);
+			return 1;
+		}
+		fmt::print("verified\n");
+	}
 	return 0;
 }
+
+#endif // AOC_BENCH
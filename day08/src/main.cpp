@@ -1,159 +1,314 @@
 #include "common.h"
+#include "seven_segment.h"
+#include <array>
 #include <bit>
 
+namespace
+{
+
+// the patterns of a display in 14 bytes, so the displays need no allocations and a display
+// can be read into a vector with one 16 byte load
 struct digit_info_t
 {
-	vector<uint8_t> signal_patterns;
-	vector<uint8_t> output_value;
+	std::array<std::uint8_t, seven_segment::digit_count> signal_patterns;
+	std::array<std::uint8_t, 4> output_value;
 };
 
-static uint8_t string_to_digit(std::string_view s)
+static_assert(sizeof (digit_info_t) == 14);
+
+// the segments are parsed straight into the patterns, which end at the spaces
+static digit_info_t parse_digit_info(string_view const &line)
 {
-	uint8_t result = 0;
-	for (auto const c : s)
+	digit_info_t result{};
+	std::size_t pattern_index = 0;
+	std::uint8_t pattern = 0;
+	auto const finish_pattern = [&]() {
+		if (pattern == 0)
+		{
+			return;
+		}
+		assert(pattern_index < result.signal_patterns.size() + result.output_value.size());
+		if (pattern_index < result.signal_patterns.size())
+		{
+			result.signal_patterns[pattern_index] = pattern;
+		}
+		else
+		{
+			result.output_value[pattern_index - result.signal_patterns.size()] = pattern;
+		}
+		++pattern_index;
+		pattern = 0;
+	};
+	for (auto const c : line)
 	{
 		if (c >= 'a' && c <= 'g')
 		{
-			auto const n = c - 'a';
-			result |= 1 << n;
+			pattern |= std::uint8_t(1) << (c - 'a');
+		}
+		else
+		{
+			finish_pattern();
 		}
 	}
+	finish_pattern();
+	assert(pattern_index == result.signal_patterns.size() + result.output_value.size());
 	return result;
 }
 
-static int solution_part_1(span<digit_info_t const> digit_infos)
+// number of output digits with a unique segment count (1, 4, 7 and 8), and the sum of the output values
+struct display_totals_t
 {
-	return digit_infos
-		.transform([](auto const &digit_info) {
-			return digit_info.output_value
-				.transform([](auto const n) { return std::popcount(n); })
-				.transform([](auto const count) { return count == 2 || count == 4 || count == 3 || count == 7 ? 1 : 0; })
-				.sum();
-		})
-		.sum();
+	std::uint64_t unique_digit_count;
+	std::uint64_t output_sum;
+};
+
+static display_totals_t combine(display_totals_t const &lhs, display_totals_t const &rhs)
+{
+	return { lhs.unique_digit_count + rhs.unique_digit_count, lhs.output_sum + rhs.output_sum };
+}
+
+// the digit of an output pattern only depends on its segment count and its overlaps with 1 and 4,
+// which don't depend on the wiring, so the digits are found by these features without any lookup
+// of the wiring: the key popcount(p) + 4 * (popcount(p & 1) + popcount(p & 4)) is different for
+// every digit modulo 16, so the digit is read from a 16 entry table, which fits into one byte shuffle
+static constexpr std::uint8_t get_feature_key(std::uint8_t pattern, std::uint8_t one, std::uint8_t four)
+{
+	auto const key = std::popcount(pattern) + 4 * (std::popcount(std::uint8_t(pattern & one)) + std::popcount(std::uint8_t(pattern & four)));
+	return static_cast<std::uint8_t>(key % 16);
 }
 
-static int solution_part_2(vector<digit_info_t> digit_infos)
+// the digit and whether it has a unique segment count for every feature key
+struct feature_tables_t
 {
-	for (auto &[signal_patterns, output_value] : digit_infos)
+	std::array<std::uint8_t, 16> digits;
+	std::array<std::uint8_t, 16> is_unique;
+};
+
+static constexpr feature_tables_t feature_tables = []() {
+	feature_tables_t result{};
+	std::array<bool, 16> is_used{};
+	for (std::size_t digit = 0; digit < seven_segment::digit_count; ++digit)
 	{
-		assert(signal_patterns.size() == 10);
-		// determine 1, 4, 7, 8 by unique segment counts
-		for (std::size_t i = 0; i < 10; ++i)
-		{
-			// 1
-			if (std::popcount(signal_patterns[i]) == 2)
-			{
-				std::swap(signal_patterns[i], signal_patterns[1]);
-				break;
-			}
-		}
-		for (std::size_t i = 0; i < 10; ++i)
-		{
-			// 4
-			if (std::popcount(signal_patterns[i]) == 4)
-			{
-				std::swap(signal_patterns[i], signal_patterns[4]);
-				break;
-			}
-		}
-		for (std::size_t i = 0; i < 10; ++i)
+		auto const pattern = seven_segment::digit_patterns[digit];
+		auto const key = get_feature_key(pattern, seven_segment::digit_patterns[1], seven_segment::digit_patterns[4]);
+		if (is_used[key])
 		{
-			// 7
-			if (std::popcount(signal_patterns[i]) == 3)
-			{
-				std::swap(signal_patterns[i], signal_patterns[7]);
-				break;
-			}
+			throw "the feature keys of two digits are the same";
 		}
-		for (std::size_t i = 0; i < 10; ++i)
-		{
-			// 8
-			if (std::popcount(signal_patterns[i]) == 7)
-			{
-				std::swap(signal_patterns[i], signal_patterns[8]);
-				break;
-			}
-		}
-		// 9 can be determined with the pattern 4 | 7, since only 9 and 8 satisfy the condition (x & (4 | 7)) == (4 | 7)
-		uint8_t const unique_9 = signal_patterns[4] | signal_patterns[7];
-		for (std::size_t const i : { 0, 2, 3, 5, 6, 9 })
+		is_used[key] = true;
+		result.digits[key] = static_cast<std::uint8_t>(digit);
+		auto const count = std::popcount(pattern);
+		result.is_unique[key] = count == 2 || count == 4 || count == 3 || count == 7 ? 1 : 0;
+	}
+	return result;
+}();
+
+// the segment count of every 7 bit pattern, because std::popcount is a function call without
+// a popcount instruction
+static constexpr std::array<std::uint8_t, 128> segment_counts = []() {
+	std::array<std::uint8_t, 128> result{};
+	for (std::size_t pattern = 0; pattern < result.size(); ++pattern)
+	{
+		result[pattern] = static_cast<std::uint8_t>(std::popcount(pattern));
+	}
+	return result;
+}();
+
+static display_totals_t get_display_totals(digit_info_t const &digit_info)
+{
+	// 1 and 4 are the patterns with 2 and 4 segments
+	std::uint8_t one = 0;
+	std::uint8_t four = 0;
+	for (auto const pattern : digit_info.signal_patterns)
+	{
+		auto const count = segment_counts[pattern];
+		one |= count == 2 ? pattern : 0;
+		four |= count == 4 ? pattern : 0;
+	}
+	auto result = display_totals_t{ 0, 0 };
+	for (auto const pattern : digit_info.output_value)
+	{
+		auto const key = static_cast<std::uint8_t>(
+			(segment_counts[pattern] + 4 * (segment_counts[pattern & one] + segment_counts[pattern & four])) % 16
+		);
+		assert(key == get_feature_key(pattern, one, four));
+		result.unique_digit_count += feature_tables.is_unique[key];
+		result.output_sum = result.output_sum * 10 + feature_tables.digits[key];
+	}
+	return result;
+}
+
+#if AOC_HAS_AVX2
+
+// the displays are decoded in batches of 32, with display i of a batch in byte i of the vectors
+inline constexpr std::size_t batch_size = 32;
+
+// the batches read 16 bytes at every display, so the last display of a batch can't be the last one
+static std::size_t get_batch_count(std::size_t display_count)
+{
+	return display_count == 0 ? 0 : (display_count - 1) / batch_size;
+}
+
+static __m256i popcount_epi8(__m256i values)
+{
+	auto const nibble_counts = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+	);
+	auto const nibble_mask = _mm256_set1_epi8(0x0f);
+	auto const low_counts = _mm256_shuffle_epi8(nibble_counts, _mm256_and_si256(values, nibble_mask));
+	auto const high_counts = _mm256_shuffle_epi8(nibble_counts, _mm256_and_si256(_mm256_srli_epi16(values, 4), nibble_mask));
+	return _mm256_add_epi8(low_counts, high_counts);
+}
+
+static display_totals_t get_batch_totals(span<digit_info_t const> digit_infos, std::size_t batch)
+{
+	auto const first_display = reinterpret_cast<std::uint8_t const *>(digit_infos.data() + batch * batch_size);
+	// rows[r] has display r in its low half and display r + 16 in its high half
+	__m256i rows[16];
+	for (auto const r : utils::iota(std::size_t(0), std::size_t(16)))
+	{
+		auto const low = _mm_loadu_si128(reinterpret_cast<__m128i const *>(first_display + r * sizeof (digit_info_t)));
+		auto const high = _mm_loadu_si128(reinterpret_cast<__m128i const *>(first_display + (r + 16) * sizeof (digit_info_t)));
+		rows[r] = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+	}
+
+	// 16x16 byte transposes in both halves, by interleaving pairs of rows with 1, 2, 4 and 8 byte elements
+	// afterwards rows[j] has byte bit_reverse(j) of the displays, with bit_reverse reversing 4 bits
+	for (auto const width : { 1, 2, 4, 8 })
+	{
+		__m256i interleaved[16];
+		for (auto const i : utils::iota(std::size_t(0), std::size_t(8)))
 		{
-			if (i != 8 && (signal_patterns[i] & unique_9) == unique_9)
+			auto const lhs = rows[2 * i];
+			auto const rhs = rows[2 * i + 1];
+			switch (width)
 			{
-				std::swap(signal_patterns[i], signal_patterns[9]);
+			case 1:
+				interleaved[i] = _mm256_unpacklo_epi8(lhs, rhs);
+				interleaved[i + 8] = _mm256_unpackhi_epi8(lhs, rhs);
 				break;
-			}
-		}
-		// 5 and 6 can be determined with 9 & ~1, since only these two and 8 and 9 satisfy the condition (x & (9 & ~1)) == (9 & ~1),
-		// and they have different segment counts
-		uint8_t const unique_56 = signal_patterns[9] & ~signal_patterns[1];
-		for (std::size_t const i : { 0, 2, 3, 5, 6 })
-		{
-			// 5
-			if ((signal_patterns[i] & unique_56) == unique_56 && std::popcount(signal_patterns[i]) == 5)
-			{
-				std::swap(signal_patterns[i], signal_patterns[5]);
+			case 2:
+				interleaved[i] = _mm256_unpacklo_epi16(lhs, rhs);
+				interleaved[i + 8] = _mm256_unpackhi_epi16(lhs, rhs);
 				break;
-			}
-		}
-		for (std::size_t const i : { 0, 2, 3, 6 })
-		{
-			// 6
-			if ((signal_patterns[i] & unique_56) == unique_56)
-			{
-				std::swap(signal_patterns[i], signal_patterns[6]);
+			case 4:
+				interleaved[i] = _mm256_unpacklo_epi32(lhs, rhs);
+				interleaved[i + 8] = _mm256_unpackhi_epi32(lhs, rhs);
 				break;
-			}
-		}
-		// 0 can be determined by its unique segment count of 6
-		for (std::size_t const i : { 0, 2, 3 })
-		{
-			if (std::popcount(signal_patterns[i]) == 6)
-			{
-				std::swap(signal_patterns[i], signal_patterns[0]);
+			default:
+				interleaved[i] = _mm256_unpacklo_epi64(lhs, rhs);
+				interleaved[i + 8] = _mm256_unpackhi_epi64(lhs, rhs);
 				break;
 			}
 		}
-		// differentiate 2 and 3 by using 1
-		if ((signal_patterns[3] & signal_patterns[1]) == signal_patterns[1])
-		{
-			// nothing
-		}
-		else
-		{
-			std::swap(signal_patterns[2], signal_patterns[3]);
-		}
+		std::copy(std::begin(interleaved), std::end(interleaved), std::begin(rows));
+	}
+	auto const get_column = [&rows](std::size_t byte_index) {
+		auto const bit_reversed = ((byte_index & 1) << 3) | ((byte_index & 2) << 1) | ((byte_index & 4) >> 1) | ((byte_index & 8) >> 3);
+		return rows[bit_reversed];
+	};
+
+	// 1 and 4 are the patterns with 2 and 4 segments
+	auto one = _mm256_setzero_si256();
+	auto four = _mm256_setzero_si256();
+	for (auto const i : utils::iota(std::size_t(0), seven_segment::digit_count))
+	{
+		auto const patterns = get_column(i);
+		auto const counts = popcount_epi8(patterns);
+		one = _mm256_or_si256(one, _mm256_and_si256(patterns, _mm256_cmpeq_epi8(counts, _mm256_set1_epi8(2))));
+		four = _mm256_or_si256(four, _mm256_and_si256(patterns, _mm256_cmpeq_epi8(counts, _mm256_set1_epi8(4))));
+	}
+
+	auto const digit_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(feature_tables.digits.data())));
+	auto const is_unique_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(feature_tables.is_unique.data())));
+	auto unique_digit_counts = _mm256_setzero_si256();
+	auto output_sums = _mm256_setzero_si256();
+	for (auto const i : utils::iota(std::size_t(0), std::size_t(4)))
+	{
+		auto const patterns = get_column(seven_segment::digit_count + i);
+		auto const overlap_counts = _mm256_add_epi8(
+			popcount_epi8(_mm256_and_si256(patterns, one)),
+			popcount_epi8(_mm256_and_si256(patterns, four))
+		);
+		// the keys are at most 31, so the shuffles only use their low 4 bits
+		auto const keys = _mm256_add_epi8(popcount_epi8(patterns), _mm256_slli_epi16(overlap_counts, 2));
+		unique_digit_counts = _mm256_add_epi8(unique_digit_counts, _mm256_shuffle_epi8(is_unique_table, keys));
+		// the digits of the 32 displays are summed into 4 lanes, which are then multiplied by the place value
+		auto const digit_sums = _mm256_sad_epu8(_mm256_shuffle_epi8(digit_table, keys), _mm256_setzero_si256());
+		output_sums = _mm256_add_epi64(
+			_mm256_mul_epu32(output_sums, _mm256_set1_epi64x(10)),
+			digit_sums
+		);
 	}
+	auto const unique_digit_count_sums = _mm256_sad_epu8(unique_digit_counts, _mm256_setzero_si256());
 
-	return digit_infos
-		.transform([](auto const &digit_info) {
-			return digit_info.output_value
-				.transform([&digit_info](auto const val) {
-					return static_cast<int>(std::find(digit_info.signal_patterns.begin(), digit_info.signal_patterns.end(), val) - digit_info.signal_patterns.begin());
-				})
-				.reduce([](auto const lhs, auto const rhs) {
-					return lhs * 10 + rhs;
-				});
-		})
-		.sum();
+	alignas(32) std::array<std::uint64_t, 4> unique_digit_count_lanes;
+	alignas(32) std::array<std::uint64_t, 4> output_sum_lanes;
+	_mm256_store_si256(reinterpret_cast<__m256i *>(unique_digit_count_lanes.data()), unique_digit_count_sums);
+	_mm256_store_si256(reinterpret_cast<__m256i *>(output_sum_lanes.data()), output_sums);
+	return {
+		utils::to_range(unique_digit_count_lanes).sum(),
+		utils::to_range(output_sum_lanes).sum(),
+	};
+}
+
+#endif // AOC_HAS_AVX2
+
+static display_totals_t get_totals(span<digit_info_t const> digit_infos)
+{
+	std::size_t first_scalar_display = 0;
+	auto result = display_totals_t{ 0, 0 };
+#if AOC_HAS_AVX2
+	auto const batch_count = get_batch_count(digit_infos.size());
+	constexpr std::size_t min_parallel_batch_count = 1 << 11;
+	result = utils::iota(std::size_t(0), batch_count)
+		.transform([digit_infos](auto const batch) { return get_batch_totals(digit_infos, batch); })
+		.par(min_parallel_batch_count)
+		.reduce(result, [](auto const &lhs, auto const &rhs) { return combine(lhs, rhs); });
+	first_scalar_display = batch_count * batch_size;
+#endif
+	for (auto const &digit_info : digit_infos.slice(first_scalar_display))
+	{
+		result = combine(result, get_display_totals(digit_info));
+	}
+	return result;
+}
+
+#ifdef AOC_BENCH
+
+static std::uint64_t solution_part_1(span<digit_info_t const> digit_infos)
+{
+	return get_totals(digit_infos).unique_digit_count;
 }
 
+static std::uint64_t solution_part_2(span<digit_info_t const> digit_infos)
+{
+	return get_totals(digit_infos).output_sum;
+}
+
+#endif // AOC_BENCH
+
+static auto read_input(fs::path const &filename)
+{
+	return read_file_parallel(filename, &parse_digit_info);
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(8, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
-	auto const digit_infos = read_file(
-		"input.txt",
-		[](auto const &line) {
-			auto const segments = split_by(line, " | ");
-			return digit_info_t{
-				split_by(segments[0], " ").transform([](auto const s) { return string_to_digit(s); }).template collect<vector>(),
-				split_by(segments[1], " ").transform([](auto const s) { return string_to_digit(s); }).template collect<vector>(),
-			};
-		}
-	);
-	auto const part_1_result = solution_part_1(digit_infos);
+	auto const digit_infos = read_input("input.txt");
+	auto const [part_1_result, part_2_result] = get_totals(digit_infos);
 	fmt::print("part 1: {}\n", part_1_result);
-	auto const part_2_result = solution_part_2(digit_infos);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -0,0 +1,264 @@
+#ifndef AOC_DAY08_SEVEN_SEGMENT_H
+#define AOC_DAY08_SEVEN_SEGMENT_H
+
+#include "common.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+
+// seven segment displays with scrambled wires, decoded with a table of all 7! = 5040 wirings
+// the ten signal patterns of a display are the digit patterns with the wires permuted, so the set
+// of patterns, which doesn't depend on their order, identifies the wiring
+// the sets of all wirings are put into a perfect hash table, so a display is decoded with one lookup
+
+namespace seven_segment
+{
+
+inline constexpr std::size_t segment_count = 7;
+inline constexpr std::size_t digit_count = 10;
+
+// segment a is bit 0, ..., segment g is bit 6
+inline constexpr std::array<std::uint8_t, digit_count> digit_patterns = {
+	0b111'0111, // abcefg
+	0b010'0100, // cf
+	0b101'1101, // acdeg
+	0b110'1101, // acdfg
+	0b010'1110, // bcdf
+	0b110'1011, // abdfg
+	0b111'1011, // abdefg
+	0b010'0101, // acf
+	0b111'1111, // abcdefg
+	0b110'1111, // abcdfg
+};
+
+inline constexpr std::int8_t no_digit = -1;
+
+// the digit of every 7 bit pattern, or no_digit
+inline constexpr std::array<std::int8_t, 128> pattern_digits = []() {
+	std::array<std::int8_t, 128> result{};
+	for (auto &digit : result)
+	{
+		digit = no_digit;
+	}
+	for (std::size_t digit = 0; digit < digit_count; ++digit)
+	{
+		result[digit_patterns[digit]] = static_cast<std::int8_t>(digit);
+	}
+	return result;
+}();
+
+// the set of 7 bit patterns as a 128 bit bitset
+struct pattern_set_t
+{
+	std::uint64_t low = 0;
+	std::uint64_t high = 0;
+
+	friend bool operator == (pattern_set_t const &lhs, pattern_set_t const &rhs) = default;
+};
+
+inline pattern_set_t get_pattern_set(span<std::uint8_t const> patterns) noexcept
+{
+	pattern_set_t result;
+	for (auto const pattern : patterns)
+	{
+		assert(pattern < 128);
+		// branchless, gcc compiles the conditional version to much slower code
+		result.low |= std::uint64_t(pattern < 64) << (pattern % 64);
+		result.high |= std::uint64_t(pattern >= 64) << (pattern % 64);
+	}
+	return result;
+}
+
+// a wiring maps the wires to the segments, with 3 bits per wire, wire a being the lowest
+using wiring_t = std::uint32_t;
+
+// the pattern of the segments that are lit by the wires in pattern
+inline std::uint8_t unscramble(wiring_t wiring, std::uint8_t pattern) noexcept
+{
+	// a fixed number of iterations, instead of one per set bit, so there are no mispredicted branches
+	std::uint8_t result = 0;
+	for (std::size_t wire = 0; wire < segment_count; ++wire)
+	{
+		result |= static_cast<std::uint8_t>(((pattern >> wire) & 1) << ((wiring >> (3 * wire)) & 7));
+	}
+	return result;
+}
+
+// perfect hash table of the pattern sets of all wirings, built with hash and displace: the sets
+// are split into buckets by one hash, and every bucket gets a displacement that puts all of its
+// sets into free slots, with the slot of a set being (base + displacement * step) % slot_count
+struct wiring_table_t
+{
+private:
+	static constexpr std::size_t wiring_count = 5040;
+	static constexpr unsigned bucket_bits = 11;
+	static constexpr unsigned slot_bits = 13;
+	static constexpr std::size_t bucket_count = std::size_t(1) << bucket_bits;
+	static constexpr std::size_t slot_count = std::size_t(1) << slot_bits;
+	static constexpr std::size_t slot_mask = slot_count - 1;
+
+	std::uint64_t _seed = 0;
+	vector<std::uint16_t> _displacements;
+	vector<wiring_t> _wirings;
+#ifndef NDEBUG
+	// the pattern sets of the wirings, to check the lookups
+	vector<pattern_set_t> _pattern_sets;
+#endif
+
+	std::uint64_t hash(pattern_set_t const &pattern_set) const noexcept
+	{
+		auto result = pattern_set.low * 0x9e37'79b9'7f4a'7c15 ^ pattern_set.high * 0xc2b2'ae3d'27d4'eb4f ^ this->_seed;
+		result ^= result >> 31;
+		result *= 0xbf58'476d'1ce4'e5b9;
+		result ^= result >> 29;
+		return result;
+	}
+
+	static std::size_t get_bucket(std::uint64_t hash) noexcept
+	{ return static_cast<std::size_t>(hash >> (64 - bucket_bits)); }
+
+	static std::size_t get_slot(std::uint64_t hash, std::size_t displacement) noexcept
+	{
+		auto const base = static_cast<std::size_t>(hash);
+		auto const step = static_cast<std::size_t>(hash >> slot_bits) | 1;
+		return (base + displacement * step) & slot_mask;
+	}
+
+	// the pattern sets and wirings of all permutations of the wires
+	static vector<std::pair<pattern_set_t, wiring_t>> get_all_wirings(void)
+	{
+		vector<std::pair<pattern_set_t, wiring_t>> result;
+		result.reserve(wiring_count);
+		// wires[s] is the wire of segment s
+		std::array<unsigned, segment_count> wires = { 0, 1, 2, 3, 4, 5, 6 };
+		do
+		{
+			std::array<std::uint8_t, digit_count> patterns{};
+			for (auto const digit : utils::iota(std::size_t(0), digit_count))
+			{
+				for (auto const segment : utils::iota(std::size_t(0), segment_count))
+				{
+					if (((digit_patterns[digit] >> segment) & 1) != 0)
+					{
+						patterns[digit] |= static_cast<std::uint8_t>(1u << wires[segment]);
+					}
+				}
+			}
+			wiring_t wiring = 0;
+			for (auto const segment : utils::iota(std::size_t(0), segment_count))
+			{
+				wiring |= static_cast<wiring_t>(segment) << (3 * wires[segment]);
+			}
+			result.push_back({ get_pattern_set(patterns), wiring });
+		} while (std::next_permutation(wires.begin(), wires.end()));
+		assert(result.size() == wiring_count);
+		return result;
+	}
+
+	// tries to place every bucket with the current seed, largest buckets first
+	bool build(span<std::pair<pattern_set_t, wiring_t> const> all_wirings)
+	{
+		auto const hashes = all_wirings
+			.transform([this](auto const &pattern_set_and_wiring) { return this->hash(pattern_set_and_wiring.first); })
+			.template collect<vector>();
+		vector<vector<std::size_t>> buckets(bucket_count);
+		for (auto const &[i, hash] : hashes.enumerate())
+		{
+			buckets[get_bucket(hash)].push_back(i);
+		}
+		auto bucket_order = utils::iota(std::size_t(0), bucket_count).collect<vector>();
+		std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](auto const lhs, auto const rhs) {
+			return buckets[lhs].size() > buckets[rhs].size();
+		});
+
+		this->_displacements.assign(bucket_count, 0);
+		this->_wirings.assign(slot_count, 0);
+#ifndef NDEBUG
+		this->_pattern_sets.assign(slot_count, pattern_set_t{});
+#endif
+		vector<bool> is_used(slot_count, false);
+		vector<std::size_t> slots;
+		for (auto const bucket : bucket_order)
+		{
+			auto const &indices = buckets[bucket];
+			if (indices.empty())
+			{
+				break;
+			}
+
+			auto const is_free = [&](std::size_t displacement) {
+				slots.clear();
+				for (auto const i : indices)
+				{
+					auto const slot = get_slot(hashes[i], displacement);
+					if (is_used[slot] || slots.contains(slot))
+					{
+						return false;
+					}
+					slots.push_back(slot);
+				}
+				return true;
+			};
+			std::size_t displacement = 0;
+			while (displacement < slot_count && !is_free(displacement))
+			{
+				++displacement;
+			}
+			if (displacement == slot_count)
+			{
+				return false;
+			}
+
+			this->_displacements[bucket] = static_cast<std::uint16_t>(displacement);
+			for (auto const &[k, slot] : slots.enumerate())
+			{
+				auto const i = indices[k];
+				is_used[slot] = true;
+				this->_wirings[slot] = all_wirings[i].second;
+#ifndef NDEBUG
+				this->_pattern_sets[slot] = all_wirings[i].first;
+#endif
+			}
+		}
+		return true;
+	}
+
+public:
+	wiring_table_t(void)
+	{
+		auto const all_wirings = get_all_wirings();
+		// the seed is changed until every bucket can be placed, which usually works with the first one
+		while (!this->build(all_wirings))
+		{
+			this->_seed += 0x9e37'79b9'7f4a'7c15;
+		}
+	}
+
+	// the wiring of a display from its ten signal patterns, in any order
+	wiring_t get_wiring(span<std::uint8_t const> signal_patterns) const noexcept
+	{
+		assert(signal_patterns.size() == digit_count);
+		auto const pattern_set = get_pattern_set(signal_patterns);
+		auto const hash = this->hash(pattern_set);
+		auto const slot = get_slot(hash, this->_displacements[get_bucket(hash)]);
+		assert(this->_pattern_sets[slot] == pattern_set);
+		return this->_wirings[slot];
+	}
+
+	// the number shown by the output digits, most significant first
+	std::uint64_t decode(span<std::uint8_t const> signal_patterns, span<std::uint8_t const> output_value) const noexcept
+	{
+		auto const wiring = this->get_wiring(signal_patterns);
+		return output_value
+			.transform([wiring](auto const pattern) {
+				auto const digit = pattern_digits[unscramble(wiring, pattern)];
+				assert(digit != no_digit);
+				return static_cast<std::uint64_t>(digit);
+			})
+			.reduce(std::uint64_t(0), [](auto const lhs, auto const rhs) { return lhs * 10 + rhs; });
+	}
+};
+
+} // namespace seven_segment
+
+#endif // AOC_DAY08_SEVEN_SEGMENT_H
@@ -1,52 +1,50 @@
 #include "common.h"
 
-static int solution_part_1(vector<vector<int>> const &heightmap)
+namespace
+{
+
+// the heightmap has a border of 9s, so the neighbours of every cell can be read without bounds checks
+using heightmap_t = grid<int>;
+
+static int solution_part_1(heightmap_t const &heightmap)
 {
 	int risk_sum = 0;
-	auto const height = heightmap.size();
-	auto const width  = heightmap[0].size();
-	for (auto const i : utils::iota(0, height))
+	for (auto const i : utils::iota(0, heightmap.height()))
 	{
-		for (auto const j : utils::iota(0, width))
+		for (auto const j : utils::iota(0, heightmap.width()))
 		{
-			auto const is_low_point =
-				(i == 0 || heightmap[i - 1][j] > heightmap[i][j])
-				&& (i == height - 1 || heightmap[i + 1][j] > heightmap[i][j])
-				&& (j == 0 || heightmap[i][j - 1] > heightmap[i][j])
-				&& (j == width - 1 || heightmap[i][j + 1] > heightmap[i][j]);
+			auto const h = heightmap(i, j);
+			auto const is_low_point = heightmap.neighbours_4(i, j).is_all([h](auto const n) { return n > h; });
 			if (is_low_point)
 			{
-				risk_sum += 1 + heightmap[i][j];
+				risk_sum += 1 + h;
 			}
 		}
 	}
 	return risk_sum;
 }
 
-static int floodfill(std::size_t i, std::size_t j, vector<vector<int>> const &heightmap, vector<vector<bool>> &occupied_map)
+static int floodfill(std::ptrdiff_t i, std::ptrdiff_t j, heightmap_t const &heightmap, grid<std::uint8_t> &occupied_map)
 {
-	auto const height = heightmap.size();
-	auto const width  = heightmap[0].size();
-	assert(occupied_map.size() == height);
-	assert(occupied_map[0].size() == width);
-	if (occupied_map[i][j] || heightmap[i][j] == 9)
+	if (occupied_map(i, j) != 0 || heightmap(i, j) == 9)
 	{
 		return 0;
 	}
 
-	occupied_map[i][j] = true;
+	occupied_map(i, j) = 1;
 
-	return 1 + (i == 0 ? 0 : floodfill(i - 1, j, heightmap, occupied_map))
-		+ (i == height - 1 ? 0 : floodfill(i + 1, j, heightmap, occupied_map))
-		+ (j == 0 ? 0 : floodfill(i, j - 1, heightmap, occupied_map))
-		+ (j == width - 1 ? 0 : floodfill(i, j + 1, heightmap, occupied_map));
+	return 1
+		+ floodfill(i - 1, j, heightmap, occupied_map)
+		+ floodfill(i + 1, j, heightmap, occupied_map)
+		+ floodfill(i, j - 1, heightmap, occupied_map)
+		+ floodfill(i, j + 1, heightmap, occupied_map);
 }
 
-static int solution_part_2(vector<vector<int>> const &heightmap)
+static int solution_part_2(heightmap_t const &heightmap)
 {
-	auto const height = heightmap.size();
-	auto const width  = heightmap[0].size();
-	auto occupied_map = vector<vector<bool>>(height, vector<bool>(width, false));
+	auto const height = heightmap.height();
+	auto const width  = heightmap.width();
+	auto occupied_map = grid<std::uint8_t>(height, width, 0, heightmap.padding());
 
 	std::array<int, 3> biggest_sizes{};
 
@@ -80,19 +78,27 @@ static int solution_part_2(vector<vector<int>> const &heightmap)
 	return biggest_sizes[0] * biggest_sizes[1] * biggest_sizes[2];
 }
 
+static auto read_input(fs::path const &filename)
+{
+	return read_grid(filename, [](char const c) { return c - '0'; }, 1, 9);
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(9, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
-	auto const heightmap = read_file(
-		"input.txt",
-		[](auto const &line) {
-			return line
-				.transform([](auto const c) { return c - '0'; })
-				.template collect<vector<int>>();
-		}
-	);
+	auto const heightmap = read_input("input.txt");
 	auto const part_1_result = solution_part_1(heightmap);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(heightmap);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
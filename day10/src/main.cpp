@@ -1,6 +1,9 @@
 #include "common.h"
 #include <stack>
 
+namespace
+{
+
 static int get_score(char c)
 {
 	switch (c)
@@ -35,7 +38,9 @@ static char get_opening_paren(char c)
 	return 0;
 }
 
-static int solution_part_1(span<string const> navigation_file)
+// the solutions work on any range of lines, so they can also be used on a stream_lines range
+template<typename Lines>
+static int solution_part_1_impl(Lines const &navigation_file)
 {
 	int highscore = 0;
 	for (auto const &line : navigation_file)
@@ -95,7 +100,9 @@ static std::int64_t get_completion_score(char c)
 	return 0;
 }
 
-static std::int64_t solution_part_2(span<string const> navigation_file)
+// the completion scores of every line are kept to find the median, so this isn't constant memory
+template<typename Lines>
+static std::int64_t solution_part_2_impl(Lines const &navigation_file)
 {
 	vector<std::int64_t> completion_scores;
 	vector<char> parentheses_stack;
@@ -148,12 +155,62 @@ static std::int64_t solution_part_2(span<string const> navigation_file)
 	return completion_scores[completion_scores.size() / 2];
 }
 
-int main(void)
+static int solution_part_1(span<string const> navigation_file)
+{
+	return solution_part_1_impl(navigation_file);
+}
+
+static std::int64_t solution_part_2(span<string const> navigation_file)
+{
+	return solution_part_2_impl(navigation_file);
+}
+
+static auto read_input(fs::path const &filename)
+{
+	return read_file(filename, [](auto const &line) { return line; });
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(10, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+// with "--stream <part> [file]" the given part is solved while reading the file, or the standard
+// input if no file is given, so the input can be piped in and doesn't need to fit into memory
+int main(int argc, char **argv)
 {
-	auto const navigation_file = read_file("input.txt", [](auto const &line) { return line; });
+	if (argc >= 3 && argc <= 4 && std::string_view(argv[1]) == "--stream")
+	{
+		auto reader = argc == 4 ? line_reader(argv[3]) : line_reader::from_stdin();
+		// the lines are only used until the next one is read, so they don't need to be copied
+		auto const lines = stream_lines(reader, [](string_view const &line) { return line; });
+		auto const part = std::string_view(argv[2]);
+		if (part == "1")
+		{
+			fmt::print("part 1: {}\n", solution_part_1_impl(lines));
+			return 0;
+		}
+		else if (part == "2")
+		{
+			fmt::print("part 2: {}\n", solution_part_2_impl(lines));
+			return 0;
+		}
+	}
+	if (argc != 1)
+	{
+		fmt::print(stderr, "usage: {} [--stream <part> [file]]\n", argv[0]);
+		return 1;
+	}
+
+	auto const navigation_file = read_input("input.txt");
 	auto const part_1_result = solution_part_1(navigation_file);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(navigation_file);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,6 +1,9 @@
 #include "common.h"
 #include <list>
 
+namespace
+{
+
 struct node_t
 {
 	string name;
@@ -185,19 +188,34 @@ static std::size_t solution_part_2(span<std::pair<string, string> const> node_pa
 	return paths.size();
 }
 
-int main(void)
+static auto read_input(fs::path const &filename)
 {
-	auto const node_pairs = read_file(
-		"input.txt",
+	return read_file(
+		filename,
 		[](auto const &line) {
-			auto const connected_nodes = split_by(line, "-");
+			auto const connected_nodes = split_by(line, "-").template collect<vector>();
 			assert(connected_nodes.size() == 2);
 			return std::pair<string, string>{ connected_nodes[0], connected_nodes[1] };
 		}
 	);
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(12, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+int main(void)
+{
+	auto const node_pairs = read_input("input.txt");
 	auto const part_1_result = solution_part_1(node_pairs);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(node_pairs);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
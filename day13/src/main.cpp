@@ -1,5 +1,8 @@
 #include "common.h"
 
+namespace
+{
+
 struct vec2
 {
 	int x = 0;
@@ -128,7 +131,7 @@ static std::size_t solution_part_1(input_data_t const &input_data)
 	return do_fold(input_data.dots, input_data.folds[0]).size();
 }
 
-static void solution_part_2(input_data_t const &input_data)
+static string solution_part_2(input_data_t const &input_data)
 {
 	vector<vec2> dots = input_data.dots;
 	for (auto const fold : input_data.folds)
@@ -139,29 +142,41 @@ static void solution_part_2(input_data_t const &input_data)
 	auto const max_x = dots.member<&vec2::x>().max();
 	auto const max_y = dots.member<&vec2::y>().max();
 
+	string result;
 	for (int y = 0; y <= max_y; ++y)
 	{
 		for (int x = 0; x <= max_x; ++x)
 		{
 			if (dots.contains(vec2{ x, y }))
 			{
-				fmt::print("#");
+				result += '#';
 			}
 			else
 			{
-				fmt::print(" ");
+				result += ' ';
 			}
 		}
-		fmt::print("\n");
+		result += '\n';
 	}
+	return result;
 }
 
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(13, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
 	auto const input_data = read_input("input.txt");
 	auto const part_1_result = solution_part_1(input_data);
 	fmt::print("part 1: {}\n", part_1_result);
-	fmt::print("part 2:\n");
-	solution_part_2(input_data);
+	auto const part_2_result = solution_part_2(input_data);
+	fmt::print("part 2:\n{}", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,6 +1,9 @@
 #include "common.h"
 #include <array>
 
+namespace
+{
+
 static constexpr std::size_t N = 'Z' - 'A' + 1;
 
 struct polymerization_instructions_t
@@ -125,6 +128,14 @@ static std::size_t solution_part_2(polymerization_instructions_t const &instruct
 	return max - min;
 }
 
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(14, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
 	auto const instructions = read_input("input.txt");
@@ -134,3 +145,5 @@ int main(void)
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,103 +1,87 @@
 #include "common.h"
 
-static int find_lowest_risk_path(vector<vector<int>> const &risk_levels)
+namespace
 {
-	auto const height = risk_levels.size();
-	auto const width = risk_levels[0].size();
+
+using risk_map_t = grid<int>;
+
+static int find_lowest_risk_path(risk_map_t const &risk_levels)
+{
+	auto const height = risk_levels.height();
+	auto const width = risk_levels.width();
 	auto const max_risk_level = std::numeric_limits<int>::max();
-	auto total_risk_levels = vector<vector<int>>(height, vector<int>(width, max_risk_level));
-	total_risk_levels[0][0] = 0; // starting position
+	// the padding is never reachable, so it doesn't affect the minimum of the neighbours
+	auto total_risk_levels = risk_map_t(height, width, max_risk_level, 1);
+	total_risk_levels(0, 0) = 0; // starting position
 
 	bool is_changed = false;
 	do {
 		is_changed = false;
 		for (auto const i : utils::iota(0, height))
 		{
+			auto const risk_row = risk_levels.row(i);
 			for (auto const j : utils::iota(0, width))
 			{
-				auto const original_surrounding_risk_level = total_risk_levels[i][j] - risk_levels[i][j];
-				auto surrounding_risk_level = original_surrounding_risk_level;
-				if (i != 0)
-				{
-					surrounding_risk_level = std::min(surrounding_risk_level, total_risk_levels[i - 1][j]);
-				}
-				if (i != height - 1)
-				{
-					surrounding_risk_level = std::min(surrounding_risk_level, total_risk_levels[i + 1][j]);
-				}
-				if (j != 0)
-				{
-					surrounding_risk_level = std::min(surrounding_risk_level, total_risk_levels[i][j - 1]);
-				}
-				if (j != width - 1)
-				{
-					surrounding_risk_level = std::min(surrounding_risk_level, total_risk_levels[i][j + 1]);
-				}
-				if (surrounding_risk_level != max_risk_level)
-				{
-				}
+				auto const original_surrounding_risk_level = total_risk_levels(i, j) - risk_row[j];
+				auto const surrounding_risk_level = std::min(
+					original_surrounding_risk_level,
+					total_risk_levels.neighbours_4(i, j).min()
+				);
 				is_changed |= surrounding_risk_level != original_surrounding_risk_level;
-				total_risk_levels[i][j] = surrounding_risk_level + risk_levels[i][j];
+				total_risk_levels(i, j) = surrounding_risk_level + risk_row[j];
 			}
 		}
 	} while (is_changed);
 
-	return total_risk_levels.back().back();
+	return total_risk_levels(height - 1, width - 1);
 }
 
-static int solution_part_1(vector<vector<int>> const &risk_levels)
+static int solution_part_1(risk_map_t const &risk_levels)
 {
 	return find_lowest_risk_path(risk_levels);
 }
 
-static int solution_part_2(vector<vector<int>> risk_levels)
+static int solution_part_2(risk_map_t const &risk_levels)
 {
-	auto const height = risk_levels.size();
-	auto const width = risk_levels[0].size();
+	auto const height = risk_levels.height();
+	auto const width = risk_levels.width();
+	auto expanded_risk_levels = risk_map_t(5 * height, 5 * width);
 
-	// horizontal expansion
-	for (auto const tile_index : utils::iota(size_t(1), size_t(5)))
+	for (auto const i : utils::iota(0, 5 * height))
 	{
-		auto const j_start = tile_index * width;
-		for (auto const i : utils::iota(0, height))
+		auto const row = expanded_risk_levels.row(i);
+		for (auto const j : utils::iota(0, 5 * width))
 		{
-			risk_levels[i].resize(5 * width);
-			for (auto const j : utils::iota(j_start, j_start + width))
-			{
-				risk_levels[i][j] = (risk_levels[i][j - width] % 9) + 1;
-			}
+			// every tile to the right or below adds one to the risk levels, wrapping from 9 to 1
+			auto const tile_distance = static_cast<int>(i / height + j / width);
+			row[j] = (risk_levels(i % height, j % width) + tile_distance - 1) % 9 + 1;
 		}
 	}
 
-	// vertical expansion
-	risk_levels.resize(5 * height);
-	for (auto const tile_index : utils::iota(size_t(1), size_t(5)))
-	{
-		auto const i_start = tile_index * height;
-		for (auto const i : utils::iota(i_start, i_start + height))
-		{
-			risk_levels[i].resize(5 * width);
-			for (auto const j : utils::iota(0, 5 * width))
-			{
-				risk_levels[i][j] = (risk_levels[i - height][j] % 9) + 1;
-			}
-		}
-	}
+	return find_lowest_risk_path(expanded_risk_levels);
+}
 
-	return find_lowest_risk_path(risk_levels);
+static auto read_input(fs::path const &filename)
+{
+	return read_grid(filename, [](char const c) -> int { return c - '0'; });
 }
 
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(15, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
-	auto const risk_levels = read_file(
-		"input.txt",
-		[](auto const &line) {
-			return line.transform([](auto const c) -> int { return c - '0'; }).template collect<vector>();
-		}
-	);
+	auto const risk_levels = read_input("input.txt");
 	auto const part_1_result = solution_part_1(risk_levels);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(risk_levels);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,5 +1,8 @@
 #include "common.h"
 
+namespace
+{
+
 struct transmission_data_t
 {
 	vector<int> bits; // always 0 or 1
@@ -174,9 +177,9 @@ static std::size_t solution_part_2(transmission_data_t const &transmission)
 	return evaluate_packet(transmission_view);
 }
 
-int main(void)
+static auto read_input(fs::path const &filename)
 {
-	auto const transmission = read_file("input.txt", [](auto const &line) { return line; })[0]
+	return read_file(filename, [](auto const &line) { return line; })[0]
 		.transform([](auto const hex_num) { return hex_num <= '9' ? hex_num - '0' : hex_num - 'A' + 10; })
 		.reduce(transmission_data_t{}, [](auto data, int hex_val) {
 			for (auto const bit : utils::iota(0, 4).transform([hex_val](auto const i) { return (hex_val >> (3 - i)) & 0x1; }))
@@ -185,9 +188,24 @@ int main(void)
 			}
 			return data;
 		});
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(16, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+int main(void)
+{
+	auto const transmission = read_input("input.txt");
 	auto const part_1_result = solution_part_1(transmission);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(transmission);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
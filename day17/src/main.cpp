@@ -1,5 +1,8 @@
 #include "common.h"
 
+namespace
+{
+
 struct vec2
 {
 	int x;
@@ -67,10 +70,10 @@ static int solution_part_2(target_area_t target_area)
 	return result;
 }
 
-int main(void)
+static auto read_input(fs::path const &filename)
 {
-	auto const target_area = read_file(
-		"input.txt",
+	return read_file(
+		filename,
 		[](auto const &line) {
 			auto line_sv = std::string_view(line);
 			assert(line_sv.starts_with("target area: x="));
@@ -90,9 +93,24 @@ int main(void)
 			return target_area_t{ vec2{ x_begin, y_begin }, vec2{ x_end - x_begin, y_end - y_begin } };
 		}
 	)[0];
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(17, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+int main(void)
+{
+	auto const target_area = read_input("input.txt");
 	auto const part_1_result = solution_part_1(target_area);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(target_area);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
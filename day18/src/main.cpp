@@ -1,5 +1,8 @@
 #include "common.h"
 
+namespace
+{
+
 struct nesting_count_and_value
 {
 	int nesting_count;
@@ -146,15 +149,31 @@ static int solution_part_2(span<snailfish_number_t const> snailfish_numbers)
 				})
 				.max();
 		})
+		.par()
 		.max();
 }
 
+static auto read_input(fs::path const &filename)
+{
+	return read_file(filename, &parse_snailfish_number);
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(18, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
-	auto const snailfish_numbers = read_file("input.txt", &parse_snailfish_number);
+	auto const snailfish_numbers = read_input("input.txt");
 	auto const part_1_result = solution_part_1(snailfish_numbers);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(snailfish_numbers);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,5 +1,7 @@
 #include "common.h"
-#include <process.h>
+
+namespace
+{
 
 struct vec3
 {
@@ -194,28 +196,31 @@ struct overlap_result_t
 
 static overlap_result_t get_overlap_count(beacon_positions_t const &sensor1, beacon_positions_t const &sensor2)
 {
-	overlap_result_t result{};
-	for (auto const &orientation : orientations)
-	{
-		for (auto const &base1 : sensor1)
-		{
-			for (auto const &base2 : sensor2)
+	// max keeps the first best orientation, like the sequential search did
+	return utils::to_range(orientations)
+		.transform([&](auto const &orientation) {
+			overlap_result_t result{};
+			for (auto const &base1 : sensor1)
 			{
-				auto const delta = base1 - orientation * base2;
-				auto const overlap_count = sensor2
-					.transform([&](auto const &pos) { return delta + orientation * pos; })
-					.transform([&](auto const &pos) { return sensor1.contains(pos) ? 1 : 0; })
-					.sum();
-				if (overlap_count > result.count)
+				for (auto const &base2 : sensor2)
 				{
-					result.count = overlap_count;
-					result.delta = delta;
-					result.orientation = orientation;
+					auto const delta = base1 - orientation * base2;
+					auto const overlap_count = sensor2
+						.transform([&](auto const &pos) { return delta + orientation * pos; })
+						.transform([&](auto const &pos) { return sensor1.contains(pos) ? 1 : 0; })
+						.sum();
+					if (overlap_count > result.count)
+					{
+						result.count = overlap_count;
+						result.delta = delta;
+						result.orientation = orientation;
+					}
 				}
 			}
-		}
-	}
-	return result;
+			return result;
+		})
+		.par()
+		.max([](auto const &lhs, auto const &rhs) { return lhs.count < rhs.count; });
 }
 
 struct position_transform_t
@@ -326,6 +331,14 @@ static std::size_t solution_part_2(span<beacon_positions_t const> sensors)
 }
 
 
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(19, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
 	auto const sensors = read_input("input.txt");
@@ -335,3 +348,5 @@ int main(void)
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,90 +1,105 @@
 #include "common.h"
 
-static std::pair<vector<bool>, vector<vector<bool>>> read_input(fs::path const &filename)
+namespace
 {
-	auto file = std::ifstream(filename);
-	string line;
-	std::pair<vector<bool>, vector<vector<bool>>> result;
 
-	std::getline(file, line);
-	result.first = line.transform([](auto const c) { return c == '#'; }).collect<vector>();
-	std::getline(file, line);
-	assert(line == "");
+// the image has two cells of padding, which hold the value of the infinite background, so every
+// cell of the enhanced image can be computed without bounds checks
+using image_t = grid<std::uint8_t>;
 
-	while (std::getline(file, line))
+static std::pair<vector<std::uint8_t>, image_t> read_input(fs::path const &filename)
+{
+	auto const data_file = mapped_file(filename);
+	auto const contents = data_file.contents();
+	auto const first_line_end = contents.find('\n');
+	assert(first_line_end != std::string_view::npos);
+
+	auto algorithm_line = string_view(contents.substr(0, first_line_end));
+	if (!algorithm_line.empty() && algorithm_line.back() == '\r')
 	{
-		result.second.emplace_back();
-		result.second.back() = line.transform([](auto const c) { return c == '#'; }).collect<vector>();
+		algorithm_line.remove_suffix(1);
 	}
+	auto algorithm = algorithm_line
+		.transform([](auto const c) -> std::uint8_t { return c == '#' ? 1 : 0; })
+		.collect<vector>();
+	assert(algorithm.size() == 512);
 
-	return result;
+	auto image = parse_grid(
+		contents.substr(first_line_end + 1),
+		[](char const c) -> std::uint8_t { return c == '#' ? 1 : 0; },
+		2, 0
+	);
+	return { std::move(algorithm), std::move(image) };
 }
 
-static vector<vector<bool>> enhance_image(vector<bool> const &algorithm, vector<vector<bool>> const &image, bool default_value)
+static image_t enhance_image(vector<std::uint8_t> const &algorithm, image_t const &image)
 {
-	auto const height = image.size();
-	auto const width = image[0].size();
-	auto result = vector<vector<bool>>(height + 2, vector<bool>(width + 2, false));
-
-	auto const get_image_value = [height, width, default_value, &image](int i, int j) -> int {
-		if (i >= 1 && i <= int(height) && j >= 1 && j <= int(width))
-		{
-			return image[i - 1][j - 1] ? 1 : 0;
-		}
-		else
-		{
-			return default_value ? 1 : 0;
-		}
-	};
+	auto const height = image.height() + 2;
+	auto const width = image.width() + 2;
+	auto const background = image(-1, -1);
+	auto result = image_t(height, width, 0, image.padding());
+	result.fill_padding(algorithm[background != 0 ? 511 : 0]);
 
-	for (int const i : utils::iota(0, height + 2))
+	// cell (i, j) of the result is centered on cell (i - 1, j - 1) of the image
+	for (auto const i : utils::iota(std::ptrdiff_t(0), static_cast<std::ptrdiff_t>(height)))
 	{
-		for (int const j : utils::iota(0, width + 2))
+		auto const top = &image(i - 2, -2);
+		auto const middle = &image(i - 1, -2);
+		auto const bottom = &image(i, -2);
+		auto const row = result.row(static_cast<std::size_t>(i));
+
+		// the 3x3 window is slid to the right, keeping the first two columns of the lookup index
+		std::size_t lookup_index =
+			(std::size_t(top[0]) << 7) | (std::size_t(top[1]) << 6)
+			| (std::size_t(middle[0]) << 4) | (std::size_t(middle[1]) << 3)
+			| (std::size_t(bottom[0]) << 1) | std::size_t(bottom[1]);
+		for (auto const j : utils::iota(std::size_t(0), width))
 		{
-			std::size_t lookup_index = 0;
-			for (int const offset_i : utils::iota(-1, 2))
-			{
-				for (int const offset_j : utils::iota(-1, 2))
-				{
-					lookup_index *= 2;
-					lookup_index += get_image_value(i + offset_i, j + offset_j);
-				}
-			}
-
-			result[i][j] = algorithm[lookup_index];
+			lookup_index = ((lookup_index << 1) & 0b110'110'110)
+				| (std::size_t(top[j + 2]) << 6)
+				| (std::size_t(middle[j + 2]) << 3)
+				| std::size_t(bottom[j + 2]);
+			row[j] = algorithm[lookup_index];
 		}
 	}
 
 	return result;
 }
 
-static int solution_part_1(vector<bool> const &algorithm, vector<vector<bool>> image)
+static int count_light_pixels(image_t const &image)
 {
-	image = enhance_image(algorithm, image, false);
-	image = enhance_image(algorithm, image, algorithm.front());
-	return image.transform(
-		[](auto const &row) {
-			return row.transform([](auto const is_light) { return is_light ? 1 : 0; }).sum();
-		}
-	).sum();
+	return image.rows()
+		.transform([](auto const row) {
+			return row.transform([](auto const is_light) -> int { return is_light; }).sum();
+		})
+		.sum();
 }
 
-static int solution_part_2(vector<bool> const &algorithm, vector<vector<bool>> image)
+static int solution_part_1(vector<std::uint8_t> const &algorithm, image_t image)
+{
+	image = enhance_image(algorithm, image);
+	image = enhance_image(algorithm, image);
+	return count_light_pixels(image);
+}
+
+static int solution_part_2(vector<std::uint8_t> const &algorithm, image_t image)
 {
-	bool default_value = false;
 	for ([[maybe_unused]] auto const _ : utils::iota(0, 50))
 	{
-		image = enhance_image(algorithm, image, default_value);
-		default_value = default_value ? algorithm.back() : algorithm.front();
+		image = enhance_image(algorithm, image);
 	}
-	assert(default_value == false);
-	return image.transform(
-		[](auto const &row) {
-			return row.transform([](auto const is_light) { return is_light ? 1 : 0; }).sum();
-		}
-	).sum();
+	assert(image(-1, -1) == 0);
+	return count_light_pixels(image);
 }
 
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(20, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
 	auto const [algorithm, image] = read_input("input.txt");
@@ -94,3 +109,5 @@ int main(void)
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
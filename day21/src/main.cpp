@@ -1,5 +1,8 @@
 #include "common.h"
 
+namespace
+{
+
 static std::pair<int, int> read_input(fs::path const &filename)
 {
 	auto file = std::ifstream(filename);
@@ -158,6 +161,14 @@ static std::size_t solution_part_2(std::pair<int, int> starting_positions)
 	return std::max(player1_wins, player2_wins);
 }
 
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(21, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
 int main(void)
 {
 	auto const starting_positions = read_input("input.txt");
@@ -167,3 +178,5 @@ int main(void)
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
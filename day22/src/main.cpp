@@ -1,5 +1,8 @@
 #include "common.h"
 
+namespace
+{
+
 struct vec3
 {
 	int x;
@@ -189,9 +192,9 @@ static std::size_t solution_part_2(span<instruction_t const> instructions)
 		.sum();
 }
 
-int main(void)
+static auto read_input(fs::path const &filename)
 {
-	auto const instructions = read_file("input.txt", [](auto const &line) {
+	return read_file_parallel(filename, [](auto const &line) {
 		auto line_sv = std::string_view(line);
 		auto const state = line_sv.starts_with("on");
 		line_sv = state ? line_sv.substr(3) : line_sv.substr(4);
@@ -212,9 +215,24 @@ int main(void)
 			}
 		};
 	});
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(22, &read_input, &solution_part_1, &solution_part_2);
+
+#else
+
+int main(void)
+{
+	auto const instructions = read_input("input.txt");
 	auto const part_1_result = solution_part_1(instructions);
 	fmt::print("part 1: {}\n", part_1_result);
 	auto const part_2_result = solution_part_2(instructions);
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -2,6 +2,9 @@
 #include <unordered_set>
 #include <queue>
 
+namespace
+{
+
 struct burrow_t
 {
 	std::array<char, 7> hallway;
@@ -18,7 +21,7 @@ struct full_burrow_t
 	bool operator == (full_burrow_t const &other) const = default;
 };
 
-static void print_burrow(burrow_t const &burrow)
+[[maybe_unused]] static void print_burrow(burrow_t const &burrow)
 {
 	string result = "#############\n";
 
@@ -74,7 +77,7 @@ static void print_burrow(burrow_t const &burrow)
 	fmt::print("{}", result);
 }
 
-static void print_burrow(full_burrow_t const &burrow)
+[[maybe_unused]] static void print_burrow(full_burrow_t const &burrow)
 {
 	string result = "#############\n";
 
@@ -119,6 +122,8 @@ static void print_burrow(full_burrow_t const &burrow)
 	fmt::print("{}", result);
 }
 
+} // namespace
+
 template<>
 struct std::hash<burrow_t>
 {
@@ -164,6 +169,9 @@ struct std::hash<full_burrow_t>
 	}
 };
 
+namespace
+{
+
 static constexpr int amphipod_movement_costs[] = { 1, 10, 100, 1000 };
 static constexpr burrow_t end_burrow = {
 	{ 0, 0, 0, 0, 0, 0, 0 },
@@ -572,6 +580,22 @@ static int solution_part_2(full_burrow_t const &burrow)
 	return queue.top().previous_energy_cost;
 }
 
+} // namespace
+
+#ifdef AOC_BENCH
+
+// part 2 uses the unfolded diagram from full_input.txt next to the given input
+static bench::day_registration const registration(
+	23,
+	[](fs::path const &filename) {
+		return std::make_pair(read_input(filename), read_full_input(filename.parent_path() / "full_input.txt"));
+	},
+	[](auto const &input) { return solution_part_1(input.first); },
+	[](auto const &input) { return solution_part_2(input.second); }
+);
+
+#else
+
 int main(void)
 {
 	auto const burrow = read_input("input.txt");
@@ -582,3 +606,5 @@ int main(void)
 	fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
@@ -1,6 +1,9 @@
 #include "common.h"
 #include <cstdint>
 
+namespace
+{
+
 enum class space_kind : std::uint8_t
 {
 	empty,
@@ -8,32 +11,40 @@ enum class space_kind : std::uint8_t
 	south,
 };
 
-static std::pair<vector<vector<space_kind>>, bool> do_cucumber_movement_step(vector<vector<space_kind>> const &seafloor)
+using seafloor_t = grid<space_kind>;
+
+// writes the next state of seafloor into result_seafloor, which must have the same size
+// returns whether any of the sea cucumbers moved
+static bool do_cucumber_movement_step(seafloor_t const &seafloor, seafloor_t &result_seafloor)
 {
-	auto const height = seafloor.size();
-	auto const width  = seafloor[0].size();
+	auto const height = seafloor.height();
+	auto const width  = seafloor.width();
+	assert(result_seafloor.height() == height && result_seafloor.width() == width);
 
-	std::pair<vector<vector<space_kind>>, bool> result{};
-	auto &result_seafloor = result.first;
-	auto &has_moved = result.second;
-	result_seafloor = vector<vector<space_kind>>(height, vector<space_kind>(width, space_kind::empty));
+	bool has_moved = false;
+	for (auto const row : result_seafloor.rows())
+	{
+		std::fill(row.begin(), row.end(), space_kind::empty);
+	}
 
 	// east facing movement
 	for (auto const i : utils::iota(0, height))
 	{
+		auto const row = seafloor.row(i);
+		auto const result_row = result_seafloor.row(i);
 		for (auto const j : utils::iota(0, width))
 		{
-			if (seafloor[i][j] == space_kind::east)
+			if (row[j] == space_kind::east)
 			{
 				auto const next_j = j == width - 1 ? 0 : j + 1;
-				if (seafloor[i][next_j] == space_kind::empty)
+				if (row[next_j] == space_kind::empty)
 				{
-					result_seafloor[i][next_j] = space_kind::east;
+					result_row[next_j] = space_kind::east;
 					has_moved |= true;
 				}
 				else
 				{
-					result_seafloor[i][j] = space_kind::east;
+					result_row[j] = space_kind::east;
 				}
 			}
 		}
@@ -42,68 +53,86 @@ static std::pair<vector<vector<space_kind>>, bool> do_cucumber_movement_step(vec
 	// south facing movement
 	for (auto const i : utils::iota(0, height))
 	{
+		auto const next_i = i == height - 1 ? 0 : i + 1;
+		auto const row = seafloor.row(i);
+		auto const next_row = seafloor.row(next_i);
+		auto const result_row = result_seafloor.row(i);
+		auto const next_result_row = result_seafloor.row(next_i);
 		for (auto const j : utils::iota(0, width))
 		{
-			if (seafloor[i][j] == space_kind::south)
+			if (row[j] == space_kind::south)
 			{
-				auto const next_i = i == height - 1 ? 0 : i + 1;
 				if (
-					result_seafloor[next_i][j] == space_kind::empty
-					&& (seafloor[next_i][j] == space_kind::empty || seafloor[next_i][j] == space_kind::east)
+					next_result_row[j] == space_kind::empty
+					&& (next_row[j] == space_kind::empty || next_row[j] == space_kind::east)
 				)
 				{
-					result_seafloor[next_i][j] = space_kind::south;
+					next_result_row[j] = space_kind::south;
 					has_moved |= true;
 				}
 				else
 				{
-					result_seafloor[i][j] = space_kind::south;
+					result_row[j] = space_kind::south;
 				}
 			}
 		}
 	}
 
-	return result;
+	return has_moved;
 }
 
-static int solution_part_1(vector<vector<space_kind>> seafloor)
+static int solution_part_1(seafloor_t seafloor)
 {
+	auto next_seafloor = seafloor_t(seafloor.height(), seafloor.width());
 	int step_count = 0;
 	while (true)
 	{
 		step_count += 1;
-		auto [next_seafloor, has_moved] = do_cucumber_movement_step(seafloor);
+		auto const has_moved = do_cucumber_movement_step(seafloor, next_seafloor);
 		if (!has_moved)
 		{
 			break;
 		}
-		seafloor = std::move(next_seafloor);
+		std::swap(seafloor, next_seafloor);
 	}
 
 	return step_count;
 }
 
-int main(void)
+static auto read_input(fs::path const &filename)
 {
-	auto const seafloor = read_file("input.txt", [](auto const &line) {
-		return line.transform([](auto const c) {
-			switch (c)
-			{
-			case '.':
-				return space_kind::empty;
-			case '>':
-				return space_kind::east;
-			case 'v':
-				return space_kind::south;
-			default:
-				assert(false);
-				return space_kind::empty;
-			}
-		}).template collect<vector>();
+	return read_grid(filename, [](char const c) {
+		switch (c)
+		{
+		case '.':
+			return space_kind::empty;
+		case '>':
+			return space_kind::east;
+		case 'v':
+			return space_kind::south;
+		default:
+			assert(false);
+			return space_kind::empty;
+		}
 	});
+}
+
+} // namespace
+
+#ifdef AOC_BENCH
+
+static bench::day_registration const registration(25, &read_input, &solution_part_1);
+
+#else
+
+int main(void)
+{
+	auto const seafloor = read_input("input.txt");
 	auto const part_1_result = solution_part_1(seafloor);
 	fmt::print("part 1: {}\n", part_1_result);
 	// auto const part_2_result = solution_part_2(navigation_file);
 	// fmt::print("part 2: {}\n", part_2_result);
 	return 0;
 }
+
+#endif // AOC_BENCH
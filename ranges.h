@@ -6,7 +6,15 @@
 #include <type_traits>
 #include <array>
 #include <cassert>
+#include <iterator>
+#include <memory>
 #include <vector>
+#include <optional>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 namespace utils
 {
@@ -14,6 +22,20 @@ namespace utils
 template<typename Range>
 struct universal_end_sentinel {};
 
+// number of elements left in a range, if it is known without iterating over it
+struct size_hint_t
+{
+	enum kind_t
+	{
+		unknown,
+		upper_bound,
+		exact,
+	};
+
+	kind_t kind;
+	std::size_t size;
+};
+
 
 namespace internal
 {
@@ -71,6 +93,10 @@ struct range_base_collect
 
 	auto collect(void) const
 	{ return this->template collect<std::vector>(); }
+
+	// replaces the contents of result, but keeps its capacity
+	template<typename Vec>
+	Vec &collect_into(Vec &result) const;
 };
 
 template<typename Range>
@@ -261,6 +287,21 @@ struct collection_base_enumerate
 	auto enumerate(void) const noexcept;
 };
 
+// ranges with fewer elements than this are reduced on the calling thread by default
+inline constexpr std::size_t default_par_min_size = 16;
+
+template<typename Range>
+struct range_base_par
+{
+	auto par(std::size_t min_size = default_par_min_size) const noexcept;
+};
+
+template<typename Collection>
+struct collection_base_par
+{
+	auto par(std::size_t min_size = default_par_min_size) const noexcept;
+};
+
 } // namespace internal
 
 
@@ -282,7 +323,8 @@ struct range_base :
 	internal::range_base_reduce     <Range>,
 	internal::range_base_max        <Range>,
 	internal::range_base_min        <Range>,
-	internal::range_base_enumerate  <Range>
+	internal::range_base_enumerate  <Range>,
+	internal::range_base_par        <Range>
 {};
 
 template<typename Collection>
@@ -303,12 +345,155 @@ struct collection_base :
 	internal::collection_base_min        <Collection>,
 	internal::collection_base_sort       <Collection>,
 	internal::collection_base_reversed   <Collection>,
-	internal::collection_base_enumerate  <Collection>
+	internal::collection_base_enumerate  <Collection>,
+	internal::collection_base_par        <Collection>
 {
 	auto as_range(void) const noexcept;
 };
 
 
+namespace internal
+{
+
+template<typename T>
+struct has_size_hint
+{
+	using yes = int;
+	using no = char;
+
+	template<typename U>
+	static auto test(int) -> decltype(std::declval<U const &>().size_hint(), yes{});
+	template<typename U>
+	static no test(...);
+
+	static constexpr bool value = std::is_same_v<decltype(test<T>(42)), yes>;
+};
+
+// the underlying iterator of a range can be an iterator with a matching end, or another range
+template<typename ItType, typename EndType>
+size_hint_t get_size_hint(ItType const &it, EndType const &end) noexcept
+{
+	if constexpr (std::sized_sentinel_for<EndType, ItType>)
+	{
+		return { size_hint_t::exact, static_cast<std::size_t>(end - it) };
+	}
+	else if constexpr (has_size_hint<ItType>::value)
+	{
+		return it.size_hint();
+	}
+	else
+	{
+		return { size_hint_t::unknown, 0 };
+	}
+}
+
+template<typename T>
+struct has_advance
+{
+	using yes = int;
+	using no = char;
+
+	template<typename U>
+	static auto test(int) -> decltype(std::declval<U &>().advance(std::size_t()), yes{});
+	template<typename U>
+	static no test(...);
+
+	static constexpr bool value = std::is_same_v<decltype(test<T>(42)), yes>;
+};
+
+// moves the underlying iterator of a range forward by n elements in constant time
+template<typename ItType>
+void advance_iterator(ItType &it, std::size_t n)
+{
+	if constexpr (has_advance<ItType>::value)
+	{
+		it.advance(n);
+	}
+	else if constexpr (std::is_integral_v<ItType>)
+	{
+		it += static_cast<ItType>(n);
+	}
+	else
+	{
+		static_assert(std::random_access_iterator<ItType>, "advance needs a random access iterator");
+		it += static_cast<std::iter_difference_t<ItType>>(n);
+	}
+}
+
+
+// a range is indexable if its elements can be computed from their index, and lowerable if it can
+// be iterated over with an indexed loop, both only if it's built on top of a contiguous range;
+// terminals like sum use this to give the compiler a loop that it can vectorize
+// an iota source isn't, because the compiler already vectorizes its increment loop, and the
+// indexed loop measured slower in aoc_ranges_bench
+template<typename Range>
+struct is_indexable : std::false_type
+{};
+
+template<typename Range>
+struct is_lowerable : std::false_type
+{};
+
+template<typename ItType, typename EndType>
+constexpr bool is_contiguous_source_v = std::contiguous_iterator<ItType> && std::is_same_v<ItType, EndType>;
+
+template<typename ItType, typename EndType>
+constexpr bool is_indexable_source_v = is_contiguous_source_v<ItType, EndType>
+	|| (is_indexable<ItType>::value && std::is_same_v<EndType, universal_end_sentinel<ItType>>);
+
+template<typename ItType, typename EndType>
+constexpr bool is_lowerable_source_v = is_contiguous_source_v<ItType, EndType>
+	|| (is_lowerable<ItType>::value && std::is_same_v<EndType, universal_end_sentinel<ItType>>);
+
+// the element at index i of an indexable source, i can be negative for elements that were already skipped
+template<typename ItType>
+decltype(auto) source_at(ItType const &it, std::ptrdiff_t i)
+{
+	if constexpr (std::contiguous_iterator<ItType>)
+	{
+		return std::to_address(it)[i];
+	}
+	else
+	{
+		return it.at_index(i);
+	}
+}
+
+// the accumulator is passed by value and returned, so it can't alias the elements and stays in a register
+template<typename ItType, typename EndType, typename T, typename BinOp>
+T source_fold(ItType const &it, EndType const &end, T init_val, BinOp &&bin_op)
+{
+	if constexpr (std::contiguous_iterator<ItType>)
+	{
+		auto const data = std::to_address(it);
+		auto const size = end - it;
+		for (std::ptrdiff_t i = 0; i < size; ++i)
+		{
+			init_val = bin_op(std::move(init_val), data[i]);
+		}
+		return init_val;
+	}
+	else
+	{
+		return it.indexed_fold(std::move(init_val), std::forward<BinOp>(bin_op));
+	}
+}
+
+// indexed loop over the elements of an indexable range
+template<typename Range, typename T, typename BinOp>
+T indexed_fold_loop(Range const &range, T init_val, BinOp &&bin_op)
+{
+	auto const size = static_cast<std::ptrdiff_t>(range.size_hint().size);
+	for (std::ptrdiff_t i = 0; i < size; ++i)
+	{
+		init_val = bin_op(std::move(init_val), range.at_index(i));
+	}
+	return init_val;
+}
+
+} // namespace internal
+
+
 template<typename ItType, typename EndType>
 struct basic_range : range_base<basic_range<ItType, EndType>>
 {
@@ -369,6 +554,18 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{ return internal::get_size_hint(this->_it, this->_end); }
+
+	void advance(std::size_t n)
+	{ internal::advance_iterator(this->_it, n); }
+
+	decltype(auto) at_index(std::ptrdiff_t i) const
+	{ return internal::source_at(this->_it, i); }
+
+	template<typename T, typename BinOp>
+	T indexed_fold(T init_val, BinOp &&bin_op) const
+	{ return internal::indexed_fold_loop(*this, std::move(init_val), std::forward<BinOp>(bin_op)); }
 };
 
 template<typename T>
@@ -426,6 +623,21 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			return { size_hint_t::exact, static_cast<std::size_t>(this->_end - this->_it) };
+		}
+		else
+		{
+			return internal::get_size_hint(this->_it, this->_end);
+		}
+	}
+
+	void advance(std::size_t n)
+	{ internal::advance_iterator(this->_it, n); }
+
 };
 
 template<typename ItType, typename EndType, typename FilterFuncType>
@@ -487,6 +699,23 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{
+		auto const result = internal::get_size_hint(this->_it, this->_end);
+		return { result.kind == size_hint_t::unknown ? size_hint_t::unknown : size_hint_t::upper_bound, result.size };
+	}
+
+	template<typename T, typename BinOp>
+	T indexed_fold(T init_val, BinOp &&bin_op) const
+	{
+		return internal::source_fold(this->_it, this->_end, std::move(init_val), [this, &bin_op](T acc, auto &&value) {
+			if (this->_filter_function(value))
+			{
+				acc = bin_op(std::move(acc), std::forward<decltype(value)>(value));
+			}
+			return acc;
+		});
+	}
 };
 
 template<typename ItType, typename EndType, typename TransformFuncType>
@@ -540,6 +769,22 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{ return internal::get_size_hint(this->_it, this->_end); }
+
+	void advance(std::size_t n)
+	{ internal::advance_iterator(this->_it, n); }
+
+	decltype(auto) at_index(std::ptrdiff_t i) const
+	{ return this->_transform_func(internal::source_at(this->_it, i)); }
+
+	template<typename T, typename BinOp>
+	T indexed_fold(T init_val, BinOp &&bin_op) const
+	{
+		return internal::source_fold(this->_it, this->_end, std::move(init_val), [this, &bin_op](T acc, auto &&value) {
+			return bin_op(std::move(acc), this->_transform_func(std::forward<decltype(value)>(value)));
+		});
+	}
 };
 
 template<typename ItType, typename EndType>
@@ -594,6 +839,24 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{ return internal::get_size_hint(this->_it, this->_end); }
+
+	void advance(std::size_t n)
+	{
+		internal::advance_iterator(this->_it, n);
+		this->_index += n;
+	}
+
+	auto at_index(std::ptrdiff_t i) const
+	{
+		using value_t = decltype(internal::source_at(this->_it, i));
+		return std::pair<std::size_t, value_t>{ this->_index + static_cast<std::size_t>(i), internal::source_at(this->_it, i) };
+	}
+
+	template<typename T, typename BinOp>
+	T indexed_fold(T init_val, BinOp &&bin_op) const
+	{ return internal::indexed_fold_loop(*this, std::move(init_val), std::forward<BinOp>(bin_op)); }
 };
 
 template<typename ItType, typename EndType>
@@ -652,6 +915,8 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{ return internal::get_size_hint(this->_it, this->_end); }
 };
 
 template<typename ItType, typename EndType, std::size_t N>
@@ -733,6 +998,23 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{ return internal::get_size_hint(this->_it, this->_end); }
+
+	// the window ending at index i, summed in the same order as operator ++ does
+	// the loop over the window is unrolled, otherwise the outer loop can't be vectorized
+	sum_t at_index(std::ptrdiff_t i) const
+	{
+		return [this, i]<std::size_t ...Is>(std::index_sequence<Is...>) {
+			sum_t result = internal::source_at(this->_it, i - static_cast<std::ptrdiff_t>(N - 1));
+			((result += internal::source_at(this->_it, i - static_cast<std::ptrdiff_t>(N - 2 - Is))), ...);
+			return result;
+		}(std::make_index_sequence<N - 1>{});
+	}
+
+	template<typename T, typename BinOp>
+	T indexed_fold(T init_val, BinOp &&bin_op) const
+	{ return internal::indexed_fold_loop(*this, std::move(init_val), std::forward<BinOp>(bin_op)); }
 };
 
 template<typename ItType, typename EndType>
@@ -799,6 +1081,335 @@ public:
 
 	decltype(auto) front(void) const noexcept
 	{ return **this; }
+	size_hint_t size_hint(void) const noexcept
+	{ return internal::get_size_hint(this->_it, this->_end); }
+
+	// the previous element is computed again instead of stored, so the loop has no dependency between iterations
+	auto at_index(std::ptrdiff_t i) const
+	{
+		using value_t = decltype(internal::source_at(this->_it, i));
+		return std::pair<prev_t, value_t>{ internal::source_at(this->_it, i - 1), internal::source_at(this->_it, i) };
+	}
+
+	template<typename T, typename BinOp>
+	T indexed_fold(T init_val, BinOp &&bin_op) const
+	{ return internal::indexed_fold_loop(*this, std::move(init_val), std::forward<BinOp>(bin_op)); }
+};
+
+
+namespace internal
+{
+
+template<typename ItType, typename EndType>
+struct is_indexable<basic_range<ItType, EndType>> : std::bool_constant<is_contiguous_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType>
+struct is_lowerable<basic_range<ItType, EndType>> : std::bool_constant<is_contiguous_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType, typename FilterFuncType>
+struct is_lowerable<filter_range<ItType, EndType, FilterFuncType>> : std::bool_constant<is_lowerable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType, typename TransformFuncType>
+struct is_indexable<transform_range<ItType, EndType, TransformFuncType>> : std::bool_constant<is_indexable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType, typename TransformFuncType>
+struct is_lowerable<transform_range<ItType, EndType, TransformFuncType>> : std::bool_constant<is_lowerable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType>
+struct is_indexable<enumerate_range<ItType, EndType>> : std::bool_constant<is_indexable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType>
+struct is_lowerable<enumerate_range<ItType, EndType>> : std::bool_constant<is_indexable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType, std::size_t N>
+struct is_indexable<running_sum_range<ItType, EndType, N>> : std::bool_constant<is_indexable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType, std::size_t N>
+struct is_lowerable<running_sum_range<ItType, EndType, N>> : std::bool_constant<is_indexable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType>
+struct is_indexable<adjacent_range<ItType, EndType>> : std::bool_constant<is_indexable_source_v<ItType, EndType>>
+{};
+
+template<typename ItType, typename EndType>
+struct is_lowerable<adjacent_range<ItType, EndType>> : std::bool_constant<is_indexable_source_v<ItType, EndType>>
+{};
+
+} // namespace internal
+
+namespace internal
+{
+
+// a pool of threads for par_range, which runs one job at a time
+// the calling thread also works on the job, and nested jobs run on the thread that started them
+struct thread_pool
+{
+private:
+	std::vector<std::jthread> _workers;
+	std::mutex _mutex;
+	std::mutex _job_mutex;
+	std::condition_variable _job_started;
+	std::condition_variable _job_finished;
+	std::function<void(std::size_t)> const *_job;
+	std::size_t _job_size;
+	std::uint64_t _job_id;
+	std::size_t _active_worker_count;
+	std::atomic<std::size_t> _next_index;
+	bool _stop;
+
+	static bool &is_in_job(void) noexcept
+	{
+		thread_local bool result = false;
+		return result;
+	}
+
+	void work_on(std::function<void(std::size_t)> const &job, std::size_t job_size)
+	{
+		is_in_job() = true;
+		for (auto i = this->_next_index.fetch_add(1); i < job_size; i = this->_next_index.fetch_add(1))
+		{
+			job(i);
+		}
+		is_in_job() = false;
+	}
+
+	void worker_loop(void)
+	{
+		std::uint64_t last_job_id = 0;
+		auto lock = std::unique_lock(this->_mutex);
+		while (true)
+		{
+			this->_job_started.wait(lock, [&]() { return this->_stop || this->_job_id != last_job_id; });
+			if (this->_stop)
+			{
+				return;
+			}
+			last_job_id = this->_job_id;
+			// a finished job has a size of 0, so a late worker doesn't touch it
+			auto const job = this->_job;
+			auto const job_size = this->_job_size;
+			++this->_active_worker_count;
+			lock.unlock();
+			if (job_size != 0)
+			{
+				this->work_on(*job, job_size);
+			}
+			lock.lock();
+			--this->_active_worker_count;
+			if (this->_active_worker_count == 0)
+			{
+				this->_job_finished.notify_all();
+			}
+		}
+	}
+
+public:
+	thread_pool(void)
+		: _workers(), _mutex(), _job_mutex(), _job_started(), _job_finished(),
+		  _job(nullptr), _job_size(0), _job_id(0), _active_worker_count(0), _next_index(0), _stop(false)
+	{
+		auto const thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+		this->_workers.reserve(thread_count - 1);
+		for (std::size_t i = 1; i < thread_count; ++i)
+		{
+			this->_workers.emplace_back([this]() { this->worker_loop(); });
+		}
+	}
+
+	thread_pool(thread_pool const &) = delete;
+	thread_pool &operator = (thread_pool const &) = delete;
+
+	~thread_pool(void)
+	{
+		{
+			auto const lock = std::lock_guard(this->_mutex);
+			this->_stop = true;
+		}
+		this->_job_started.notify_all();
+		// join the workers while the mutex and the condition variables are still alive
+		this->_workers.clear();
+	}
+
+	static thread_pool &get(void)
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+	// calls job(i) for every i in [0, job_size), in no particular order
+	void run(std::size_t job_size, std::function<void(std::size_t)> const &job)
+	{
+		if (this->_workers.empty() || job_size <= 1 || is_in_job() || !this->_job_mutex.try_lock())
+		{
+			for (std::size_t i = 0; i < job_size; ++i)
+			{
+				job(i);
+			}
+			return;
+		}
+
+		auto const job_lock = std::lock_guard(this->_job_mutex, std::adopt_lock);
+		{
+			auto const lock = std::lock_guard(this->_mutex);
+			this->_job = &job;
+			this->_job_size = job_size;
+			this->_next_index = 0;
+			++this->_job_id;
+		}
+		this->_job_started.notify_all();
+		this->work_on(job, job_size);
+
+		auto lock = std::unique_lock(this->_mutex);
+		this->_job_finished.wait(lock, [this]() { return this->_active_worker_count == 0; });
+		this->_job = nullptr;
+		this->_job_size = 0;
+	}
+};
+
+} // namespace internal
+
+// parallel versions of the reducing functions of a random access range
+// the range is split into chunks that only depend on its size, and the results of the chunks
+// are combined in order, so the result doesn't depend on the number of threads
+// a range smaller than min_size isn't worth starting the thread pool for, and is one chunk,
+// which runs on the calling thread
+template<typename Range>
+struct par_range
+{
+private:
+	static constexpr std::size_t max_chunk_count = 64;
+
+	Range _range;
+	std::size_t _size;
+	std::size_t _min_size;
+
+	// chunk_func(chunk, count) reduces count elements starting at chunk,
+	// combine_func(lhs, rhs) combines the results of two adjacent chunks
+	template<typename ChunkFunc, typename CombineFunc>
+	auto reduce_chunks(ChunkFunc &&chunk_func, CombineFunc &&combine_func) const
+	{
+		using result_t = std::decay_t<decltype(chunk_func(std::declval<Range>(), std::size_t()))>;
+		assert(this->_size != 0);
+		auto const chunk_count = this->_size < this->_min_size ? std::size_t(1) : std::min(this->_size, max_chunk_count);
+		std::vector<std::optional<result_t>> chunk_results(chunk_count);
+		internal::thread_pool::get().run(chunk_count, [&](std::size_t chunk_index) {
+			auto const begin = this->_size * chunk_index / chunk_count;
+			auto const end = this->_size * (chunk_index + 1) / chunk_count;
+			auto chunk = this->_range;
+			chunk.advance(begin);
+			chunk_results[chunk_index].emplace(chunk_func(std::move(chunk), end - begin));
+		});
+
+		result_t result = std::move(*chunk_results[0]);
+		for (std::size_t i = 1; i < chunk_count; ++i)
+		{
+			result = combine_func(std::move(result), std::move(*chunk_results[i]));
+		}
+		return result;
+	}
+
+	template<typename BinOp>
+	auto reduce_chunks(BinOp &&bin_op) const
+	{
+		return this->reduce_chunks(
+			[&bin_op](Range chunk, std::size_t count) {
+				std::decay_t<decltype(*chunk)> result(*chunk);
+				for (--count, ++chunk; count != 0; --count, ++chunk)
+				{
+					result = bin_op(std::move(result), *chunk);
+				}
+				return result;
+			},
+			bin_op
+		);
+	}
+
+public:
+	par_range(Range range, std::size_t size, std::size_t min_size)
+		: _range(std::move(range)), _size(size), _min_size(min_size)
+	{}
+
+	std::size_t count(void) const noexcept
+	{ return this->_size; }
+
+	auto sum(void) const
+	{
+		using value_t = std::decay_t<decltype(*this->_range)>;
+		if (this->_size == 0)
+		{
+			return value_t{};
+		}
+		return this->reduce_chunks(
+			[](Range chunk, std::size_t count) {
+				value_t result{};
+				for (; count != 0; --count, ++chunk)
+				{
+					result += *chunk;
+				}
+				return result;
+			},
+			[](value_t lhs, value_t rhs) {
+				lhs += std::move(rhs);
+				return lhs;
+			}
+		);
+	}
+
+	// bin_op must be associative
+	template<typename BinOp>
+	auto reduce(BinOp &&bin_op) const
+	{ return this->reduce_chunks(bin_op); }
+
+	template<typename T, typename BinOp>
+	auto reduce(T init_val, BinOp &&bin_op) const
+	{
+		if (this->_size == 0)
+		{
+			return init_val;
+		}
+		init_val = bin_op(std::move(init_val), this->reduce_chunks(bin_op));
+		return init_val;
+	}
+
+	auto max(void) const
+	{ return this->max([](auto const &lhs, auto const &rhs) { return lhs < rhs; }); }
+
+	template<typename Cmp>
+	auto max(Cmp &&cmp) const
+	{
+		// keeps the first of equal elements, like range_base_max
+		return this->reduce_chunks([&cmp](auto lhs, auto &&rhs) {
+			if (cmp(lhs, rhs))
+			{
+				lhs = std::forward<decltype(rhs)>(rhs);
+			}
+			return lhs;
+		});
+	}
+
+	auto min(void) const
+	{ return this->min([](auto const &lhs, auto const &rhs) { return lhs < rhs; }); }
+
+	template<typename Cmp>
+	auto min(Cmp &&cmp) const
+	{
+		return this->reduce_chunks([&cmp](auto lhs, auto &&rhs) {
+			if (cmp(rhs, lhs))
+			{
+				lhs = std::forward<decltype(rhs)>(rhs);
+			}
+			return lhs;
+		});
+	}
 };
 
 
@@ -943,6 +1554,20 @@ struct has_emplace_back
 	static constexpr bool value = std::is_same_v<decltype(test<T, Ts...>(42)), yes>;
 };
 
+template<typename T>
+struct has_reserve
+{
+	using yes = int;
+	using no = char;
+
+	template<typename U>
+	static auto test(int) -> decltype(std::declval<U>().reserve(std::size_t()), yes{});
+	template<typename U>
+	static no test(...);
+
+	static constexpr bool value = std::is_same_v<decltype(test<T>(42)), yes>;
+};
+
 } // namespace internal
 
 template<typename Range>
@@ -951,17 +1576,7 @@ auto range_base_collect<Range>::collect(void) const
 {
 	auto const self = static_cast<Range const *>(this);
 	Vec<std::decay_t<decltype(self->operator*())>> result;
-	for (auto &&it : *self)
-	{
-		if constexpr (internal::has_emplace_back<decltype(result), decltype(it)>::value)
-		{
-			result.emplace_back(std::forward<decltype(it)>(it));
-		}
-		else
-		{
-			result.push_back(std::forward<decltype(it)>(it));
-		}
-	}
+	this->collect_into(result);
 	return result;
 }
 
@@ -969,11 +1584,29 @@ template<typename Range>
 template<typename Vec>
 Vec range_base_collect<Range>::collect(void) const
 {
-	auto const self = static_cast<Range const *>(this);
 	Vec result;
+	this->collect_into(result);
+	return result;
+}
+
+template<typename Range>
+template<typename Vec>
+Vec &range_base_collect<Range>::collect_into(Vec &result) const
+{
+	auto const self = static_cast<Range const *>(this);
+	result.clear();
+	if constexpr (internal::has_reserve<Vec>::value)
+	{
+		// an upper bound isn't reserved, because a selective filter would leave most of it unused
+		auto const size_hint = ::utils::internal::get_size_hint(*self, universal_end_sentinel<Range>{});
+		if (size_hint.kind == size_hint_t::exact)
+		{
+			result.reserve(size_hint.size);
+		}
+	}
 	for (auto &&it : *self)
 	{
-		if constexpr (internal::has_emplace_back<decltype(result), decltype(it)>::value)
+		if constexpr (internal::has_emplace_back<Vec, decltype(it)>::value)
 		{
 			result.emplace_back(std::forward<decltype(it)>(it));
 		}
@@ -989,6 +1622,11 @@ template<typename Range>
 std::size_t range_base_count<Range>::count(void) const noexcept
 {
 	auto const self = static_cast<Range const *>(this);
+	auto const size_hint = ::utils::internal::get_size_hint(*self, universal_end_sentinel<Range>{});
+	if (size_hint.kind == size_hint_t::exact)
+	{
+		return size_hint.size;
+	}
 	auto &&it = self->begin();
 	auto &&end = self->end();
 	std::size_t result = 0;
@@ -1081,9 +1719,19 @@ auto range_base_sum<Range>::sum(void) const noexcept
 {
 	auto const self = static_cast<Range const *>(this);
 	std::decay_t<decltype(self->operator*())> result{};
-	for (auto &&it : *self)
+	if constexpr (::utils::internal::is_lowerable<Range>::value)
+	{
+		result = self->indexed_fold(std::move(result), [](auto acc, auto &&value) {
+			acc += std::forward<decltype(value)>(value);
+			return acc;
+		});
+	}
+	else
 	{
-		result += std::forward<decltype(it)>(it);
+		for (auto &&it : *self)
+		{
+			result += std::forward<decltype(it)>(it);
+		}
 	}
 	return result;
 }
@@ -1149,11 +1797,18 @@ template<typename T, typename BinOp>
 auto range_base_reduce<Range>::reduce(T init_val, BinOp &&bin_op) const noexcept
 {
 	auto const self = static_cast<Range const *>(this);
-	for (auto &&it : *self)
+	if constexpr (::utils::internal::is_lowerable<Range>::value)
 	{
-		init_val = bin_op(std::move(init_val), std::forward<decltype(it)>(it));
+		return self->indexed_fold(std::move(init_val), bin_op);
+	}
+	else
+	{
+		for (auto &&it : *self)
+		{
+			init_val = bin_op(std::move(init_val), std::forward<decltype(it)>(it));
+		}
+		return init_val;
 	}
-	return init_val;
 }
 
 template<typename Collection>
@@ -1299,6 +1954,19 @@ template<typename Collection>
 auto collection_base_enumerate<Collection>::enumerate(void) const noexcept
 { return static_cast<Collection const *>(this)->as_range().enumerate(); }
 
+template<typename Range>
+auto range_base_par<Range>::par(std::size_t min_size) const noexcept
+{
+	auto const self = static_cast<Range const *>(this);
+	auto const size_hint = ::utils::internal::get_size_hint(*self, universal_end_sentinel<Range>{});
+	assert(size_hint.kind == size_hint_t::exact);
+	return par_range<Range>(*self, size_hint.size, min_size);
+}
+
+template<typename Collection>
+auto collection_base_par<Collection>::par(std::size_t min_size) const noexcept
+{ return static_cast<Collection const *>(this)->as_range().par(min_size); }
+
 } // namespace internal
 
 } // namespace utils